@@ -0,0 +1,54 @@
+#ifndef WLGDBiasApplyWeightWindow_hh
+#define WLGDBiasApplyWeightWindow_hh 1
+
+#include "G4ParticleChange.hh"
+#include "G4ParticleChangeForNothing.hh"
+#include "G4VBiasingOperation.hh"
+
+class WLGDBiasWeightWindow;
+
+class WLGDBiasApplyWeightWindow : public G4VBiasingOperation
+{
+public:
+  // -- Constructor: takes the operator providing the windows
+  WLGDBiasApplyWeightWindow(WLGDBiasWeightWindow* windows,
+                            G4String              name = "ApplyWeightWindow");
+  virtual ~WLGDBiasApplyWeightWindow() = default;
+
+  // ----------------------------------------------
+  // -- Methods from the base class, not used here:
+  // ----------------------------------------------
+  virtual const G4VBiasingInteractionLaw* ProvideOccurenceBiasingInteractionLaw(
+    const G4BiasingProcessInterface*, G4ForceCondition&)
+  {
+    return 0;
+  }
+  virtual G4VParticleChange* ApplyFinalStateBiasing(const G4BiasingProcessInterface*,
+                                                    const G4Track*, const G4Step*,
+                                                    G4bool&)
+  {
+    return 0;
+  }
+
+  // -----------------------------------------------
+  // -- Methods used for non-physics based biasing:
+  // -----------------------------------------------
+  // -- The operation is forced on every step, and acts only when the step ends
+  // -- on a volume boundary:
+  virtual G4double DistanceToApplyOperation(const G4Track*, G4double,
+                                            G4ForceCondition* condition);
+  // -- Splits the track above the window of the volume it enters, roulettes it
+  // -- below:
+  virtual G4VParticleChange* GenerateBiasingFinalState(const G4Track* track,
+                                                       const G4Step*  step);
+
+private:
+  // -- upper limit on the copies made of one track in one go
+  static constexpr G4int kMaxSplit = 100;
+
+  WLGDBiasWeightWindow*      fWindows;
+  G4ParticleChange           fParticleChange;
+  G4ParticleChangeForNothing fParticleChangeForNothing;
+};
+
+#endif
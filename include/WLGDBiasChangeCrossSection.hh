@@ -3,8 +3,10 @@
 
 #include "G4VBiasingOperator.hh"
 class G4BOptnChangeCrossSection;
+class G4LogicalVolume;
 class G4ParticleDefinition;
-#include <map>
+#include <istream>
+#include <vector>
 
 #include "G4BOptnChangeCrossSection.hh"
 #include "G4BiasingProcessInterface.hh"
@@ -13,21 +15,50 @@ class G4ParticleDefinition;
 #include "G4VProcess.hh"
 #include "Randomize.hh"
 #include "G4InteractionLawPhysical.hh"
+#include "G4ThreeVector.hh"
 
 class WLGDBiasChangeCrossSection : public G4VBiasingOperator
 {
 public:
+  // -- A factor set by macro for a particle, wrapped process and logical volume,
+  // -- where "*" matches any name. The last matching entry wins.
+  struct FactorOverride
+  {
+    G4String particle;
+    G4String process;
+    G4String volume;
+    G4double factor = 1.0;
+  };
+
+  // -- The factors shared by all operators, read at each start of run so that
+  // -- they may change between runs:
+  struct FactorTable
+  {
+    G4double                    neutronBias      = 1.0;
+    G4double                    muonBias         = 1.0;
+    G4double                    neutronYieldBias = 1.0;
+    std::vector<FactorOverride> overrides;
+    // -- exponential transform of the neutron cross-sections toward a point,
+    // -- off for a strength of zero:
+    G4double                    transformStrength = 0.;
+    G4ThreeVector               transformTarget;
+  };
+
   // ------------------------------------------------------------
   // -- Constructor: takes the name of the particle type to bias:
   // ------------------------------------------------------------
   WLGDBiasChangeCrossSection(G4String particleToBias, G4String name = "ChangeXS");
   virtual ~WLGDBiasChangeCrossSection();
 
-  // -- method called at beginning of run:
+  // -- method called at beginning of run, resolves the bias factor table:
   virtual void StartRun();
   void         SetNeutronFactor(G4double nf) { fNeutronBias = nf; }
   void         SetNeutronYieldFactor(G4double nf) { fNeutronYieldBias = nf; }
   void         SetMuonFactor(G4double mf) { fMuonBias = mf; }
+  // -- the table replaces the factors above at each start of run:
+  void SetFactorTable(const FactorTable* table) { fFactorTable = table; }
+  // -- ignore the built-in factors, leaving analog all but the overridden processes:
+  void SetOverridesOnly(G4bool answer) { fOverridesOnly = answer; }
 
 private:
   // -----------------------------
@@ -49,6 +80,13 @@ private:
     return 0;
   }
 
+  // -- Factor for the wrapped process of the given name in the given volume,
+  // -- the built-in one unless overridden:
+  G4double ComputeFactor(const G4String& processName,
+                         const G4LogicalVolume* volume) const;
+  G4double DefaultFactor(const G4String& processName,
+                         const G4LogicalVolume* volume) const;
+
 private:
   // -- ("using" is avoid compiler complaining against (false) method shadowing.)
   using G4VBiasingOperator::OperationApplied;
@@ -67,9 +105,14 @@ private:
                                 const G4VParticleChange* particleChangeProduced);
 
 private:
-  // -- List of associations between processes and biasing operations:
-  std::map<const G4BiasingProcessInterface*, G4BOptnChangeCrossSection*>
-                              fChangeCrossSectionOperations;
+  // -- Processes under biasing and their biasing operations, by process slot:
+  std::vector<const G4BiasingProcessInterface*> fProcesses;
+  std::vector<G4BOptnChangeCrossSection*>       fChangeCrossSectionOperations;
+  // -- Bias factor by [slot * fNumberOfVolumeIDs + logical volume instance ID]:
+  std::vector<G4double>       fFactors;
+  G4int                       fNumberOfVolumeIDs = 0;
+  const FactorTable*          fFactorTable = nullptr;
+  G4bool                      fOverridesOnly = false;
   G4bool                      fSetup;
   const G4ParticleDefinition* fParticleToBias;
   G4String                    fpname;
@@ -83,5 +126,18 @@ private:
   // -- Experimental: Scalar to manually adjust all the cross-sections acting into the neutron yield
   G4double                    fNeutronYieldBias = 1.0;
 
+  // -- Exponential transform: all cross-sections are scaled by (1 - p mu), with mu
+  // -- the cosine between the direction and the target point as seen by the particle
+  G4double                    fTransformStrength = 0.;
+  G4ThreeVector               fTransformTarget;
+
 };
+
+// -- reads "<particle> <process> <volume> <factor>", as given to /WLGD/bias/setFactor
+inline std::istream& operator>>(std::istream&                                 in,
+                                WLGDBiasChangeCrossSection::FactorOverride& entry)
+{
+  return in >> entry.particle >> entry.process >> entry.volume >> entry.factor;
+}
+
 #endif
@@ -0,0 +1,101 @@
+#ifndef WLGDBiasForcedCapture_hh
+#define WLGDBiasForcedCapture_hh 1
+
+#include "G4VBiasingOperator.hh"
+class G4BOptnChangeCrossSection;
+class G4BOptnCloning;
+class G4ParticleDefinition;
+class WLGDBiasTruncatedExpCapture;
+class WLGDCountAccumulable;
+
+#include <map>
+
+#include "G4BiasingProcessInterface.hh"
+
+class WLGDBiasForcedCapture : public G4VBiasingOperator
+{
+public:
+  // ------------------------------------------------------------------------
+  // -- Constructor: takes the name of the particle type to bias and the name
+  // -- of its (wrapped) capture process:
+  // ------------------------------------------------------------------------
+  WLGDBiasForcedCapture(const G4String& particleToBias,
+                        G4String        captureProcess = "nCapture",
+                        G4String        name           = "ForcedCapture");
+  virtual ~WLGDBiasForcedCapture();
+
+  // -- counters of the clones and their captures, in the "ForcedCapture"
+  // -- accumulable; the capture weight is summed
+  enum CaptureCount
+  {
+    kClones = 0,
+    kCaptures,
+    kCaptureWeight,
+    kNumberOfCaptureCounts
+  };
+
+  // -- method called at beginning of run, finds the capture process:
+  virtual void StartRun();
+  // -- method called at the time a tracking of a particle starts, tells the
+  // -- forced capture branch from the others:
+  virtual void StartTracking(const G4Track* track);
+
+private:
+  // -----------------------------
+  // -- Mandatory from base class:
+  // -----------------------------
+  // -- This method clones the particle entering the volume:
+  virtual G4VBiasingOperation* ProposeNonPhysicsBiasingOperation(
+    const G4Track* track, const G4BiasingProcessInterface* callingProcess);
+  // -- This method forbids the capture of the uncollided particle and forces
+  // -- the capture of its clone:
+  virtual G4VBiasingOperation* ProposeOccurenceBiasingOperation(
+    const G4Track* track, const G4BiasingProcessInterface* callingProcess);
+  // -- Methods not used:
+  virtual G4VBiasingOperation* ProposeFinalStateBiasingOperation(
+    const G4Track*, const G4BiasingProcessInterface*)
+  {
+    return 0;
+  }
+
+private:
+  // -- ("using" is to avoid compiler complaining against (false) method shadowing.)
+  using G4VBiasingOperator::OperationApplied;
+
+  // -- Marks the clone once the cloning operation has been applied:
+  virtual void OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                                G4BiasingAppliedCase             biasingCase,
+                                G4VBiasingOperation*             operationApplied,
+                                const G4VParticleChange*         particleChangeProduced);
+  // -- Counts the forced captures of the clones:
+  virtual void OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                                G4BiasingAppliedCase             biasingCase,
+                                G4VBiasingOperation*     occurenceOperationApplied,
+                                G4double                 weightForOccurenceInteraction,
+                                G4VBiasingOperation*     finalStateOperationApplied,
+                                const G4VParticleChange* particleChangeProduced);
+  void Count(G4int which, G4double value = 1.);
+
+private:
+  enum BranchState
+  {
+    kAnalog,
+    kUncollided,
+    kForced
+  };
+
+  G4BOptnCloning*                  fCloningOperation;
+  G4BOptnChangeCrossSection*       fNoCaptureOperation;
+  WLGDBiasTruncatedExpCapture*     fForcedCaptureOperation;
+  std::map<const G4BiasingProcessInterface*, G4BOptnChangeCrossSection*>
+                                   fNoInteractionOperations;
+  const G4ParticleDefinition*      fParticleToBias;
+  G4String                         fCaptureProcessName;
+  const G4BiasingProcessInterface* fCaptureProcess = nullptr;
+  G4int                            fCloneModelID;
+  BranchState                      fState = kAnalog;
+  G4double                         fCaptureWeight = 0.;  // weight at the step start
+  WLGDCountAccumulable*            fCounts        = nullptr;
+};
+
+#endif
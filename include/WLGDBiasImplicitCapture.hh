@@ -0,0 +1,87 @@
+#ifndef WLGDBiasImplicitCapture_hh
+#define WLGDBiasImplicitCapture_hh 1
+
+#include "G4VBiasingOperator.hh"
+class G4BOptnChangeCrossSection;
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class WLGDBiasWeightRoulette;
+class WLGDCountAccumulable;
+
+#include <set>
+#include <vector>
+
+#include "G4BiasingProcessInterface.hh"
+
+class WLGDBiasImplicitCapture : public G4VBiasingOperator
+{
+public:
+  // ------------------------------------------------------------------------
+  // -- Constructor: takes the name of the particle type to bias, the logical
+  // -- volumes by name, and the weight floor below which the particle is
+  // -- rouletted to the survival weight:
+  // ------------------------------------------------------------------------
+  WLGDBiasImplicitCapture(const G4String&              particleToBias,
+                          const std::vector<G4String>& volumes, G4double weightFloor,
+                          G4double survivalWeight, G4String captureProcess = "nCapture",
+                          G4String name = "ImplicitCapture");
+  virtual ~WLGDBiasImplicitCapture();
+
+  // -- counters of the roulette below the weight floor, in the "ImplicitCapture"
+  // -- accumulable
+  enum RouletteCount
+  {
+    kRouletteKilled = 0,
+    kRouletteSurvived,
+    kNumberOfRouletteCounts
+  };
+
+  // -- method called at beginning of run, resolves the volume names and finds
+  // -- the capture process:
+  virtual void StartRun();
+
+private:
+  // -----------------------------
+  // -- Mandatory from base class:
+  // -----------------------------
+  // -- This method replaces the capture by a weight reduction:
+  virtual G4VBiasingOperation* ProposeOccurenceBiasingOperation(
+    const G4Track* track, const G4BiasingProcessInterface* callingProcess);
+  // -- This method roulettes the particle below the weight floor:
+  virtual G4VBiasingOperation* ProposeNonPhysicsBiasingOperation(
+    const G4Track* track, const G4BiasingProcessInterface* callingProcess);
+  // -- Methods not used:
+  virtual G4VBiasingOperation* ProposeFinalStateBiasingOperation(
+    const G4Track*, const G4BiasingProcessInterface*)
+  {
+    return 0;
+  }
+
+  // -- ("using" is to avoid compiler complaining against (false) method shadowing.)
+  using G4VBiasingOperator::OperationApplied;
+
+  // -- Counts the outcome of the roulette:
+  virtual void OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                                G4BiasingAppliedCase             biasingCase,
+                                G4VBiasingOperation*             operationApplied,
+                                const G4VParticleChange*         particleChangeProduced);
+
+  G4bool IsImplicit(const G4Track* track) const
+  {
+    return track->GetDefinition() == fParticleToBias &&
+           fImplicitVolumes.count(track->GetVolume()->GetLogicalVolume()) != 0;
+  }
+
+private:
+  G4BOptnChangeCrossSection*          fNoCaptureOperation;
+  WLGDBiasWeightRoulette*             fRouletteOperation;
+  const G4ParticleDefinition*         fParticleToBias;
+  std::vector<G4String>               fVolumes;
+  std::set<const G4LogicalVolume*>    fImplicitVolumes;
+  G4double                            fWeightFloor;
+  G4String                            fCaptureProcessName;
+  const G4BiasingProcessInterface*    fCaptureProcess = nullptr;
+  WLGDCountAccumulable*               fCounts         = nullptr;
+};
+
+#endif
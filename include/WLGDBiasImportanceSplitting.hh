@@ -0,0 +1,75 @@
+#ifndef WLGDBiasImportanceSplitting_hh
+#define WLGDBiasImportanceSplitting_hh 1
+
+#include "G4VBiasingOperator.hh"
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class WLGDBiasSplitOrKillOnBoundary;
+class WLGDCountAccumulable;
+
+#include <map>
+
+#include "G4BiasingProcessInterface.hh"
+
+class WLGDBiasImportanceSplitting : public G4VBiasingOperator
+{
+public:
+  // ------------------------------------------------------------------------
+  // -- Constructor: takes the name of the particle type to split, and the
+  // -- importance of each logical volume by name; unlisted volumes have
+  // -- importance 1:
+  // ------------------------------------------------------------------------
+  WLGDBiasImportanceSplitting(const G4String&                        particleToBias,
+                              const std::map<G4String, G4double>& importances,
+                              G4String name = "ImportanceSplitting");
+  virtual ~WLGDBiasImportanceSplitting();
+
+  // -- counters of the splitting and roulette, in the "ImportanceSplitting"
+  // -- accumulable
+  enum SplitCount
+  {
+    kSplitCopies = 0,
+    kRouletteKilled,
+    kRouletteSurvived,
+    kNumberOfSplitCounts
+  };
+  static const char* GetCountName(G4int which);
+
+  // -- method called at beginning of run, resolves the volume names:
+  virtual void StartRun();
+
+  G4double GetImportance(const G4LogicalVolume* volume) const
+  {
+    auto it = fImportanceOfVolume.find(volume);
+    return (it == fImportanceOfVolume.end()) ? 1. : it->second;
+  }
+  void Count(G4int which, G4double value = 1.);
+
+private:
+  // -----------------------------
+  // -- Mandatory from base class:
+  // -----------------------------
+  // -- This method returns the splitting operation for the particle to bias:
+  virtual G4VBiasingOperation* ProposeNonPhysicsBiasingOperation(
+    const G4Track* track, const G4BiasingProcessInterface* callingProcess);
+  // -- Methods not used:
+  virtual G4VBiasingOperation* ProposeOccurenceBiasingOperation(
+    const G4Track*, const G4BiasingProcessInterface*)
+  {
+    return 0;
+  }
+  virtual G4VBiasingOperation* ProposeFinalStateBiasingOperation(
+    const G4Track*, const G4BiasingProcessInterface*)
+  {
+    return 0;
+  }
+
+private:
+  WLGDBiasSplitOrKillOnBoundary*               fSplitAndKillOperation;
+  const G4ParticleDefinition*                  fParticleToBias;
+  std::map<G4String, G4double>                 fImportances;
+  std::map<const G4LogicalVolume*, G4double>   fImportanceOfVolume;
+  WLGDCountAccumulable*                        fCounts = nullptr;
+};
+
+#endif
@@ -28,10 +28,22 @@ public:
   // -- Each particle type for which its name is passed will be biased; *provided*
   // -- that the proper calls to biasingPhysics->Bias(particleName) have been done
   // -- in the main program.
-  void AddParticle(const G4String& particleName);
+  // -- With overridesOnly, only the factors set by /WLGD/bias/setFactor apply to it.
+  void   AddParticle(const G4String& particleName, G4bool overridesOnly = false);
+  G4bool HasParticle(const G4String& particleName) const;
+  // -- factor table handed to the operators of all particles:
+  void SetFactorTable(const WLGDBiasChangeCrossSection::FactorTable* table);
   void SetNeutronFactor(G4double nf) { fNeutronBias = nf; }
   void SetMuonFactor(G4double mf) { fMuonBias = mf; }
   void SetNeutronYieldFactor(G4double mf) { fNeutronYieldBias = mf; }
+  // -- Operator consulted for non-physics biasing (e.g. splitting on boundaries)
+  // -- in the volumes this operator is attached to; it is not owned:
+  void SetNonPhysicsOperator(G4VBiasingOperator* optr) { fNonPhysicsOperator = optr; }
+  // -- Operator consulted first for a particle type (e.g. forced or implicit
+  // -- capture) in these volumes; the cross-section operator of the particle, if
+  // -- any, and the non-physics operator above act when it proposes nothing.
+  // -- It is not owned:
+  void SetParticleOperator(const G4String& particleName, G4VBiasingOperator* optr);
 
 private:
   // -----------------------------
@@ -41,17 +53,12 @@ private:
   // occurence:
   virtual G4VBiasingOperation* ProposeOccurenceBiasingOperation(
     const G4Track* track, const G4BiasingProcessInterface* callingProcess);
-  // -- Methods not used:
+  // -- This method returns the final state operation of the particle operator:
   virtual G4VBiasingOperation* ProposeFinalStateBiasingOperation(
-    const G4Track*, const G4BiasingProcessInterface*)
-  {
-    return 0;
-  }
+    const G4Track* track, const G4BiasingProcessInterface* callingProcess);
+  // -- This method returns the operation of the non-physics operator, if any:
   virtual G4VBiasingOperation* ProposeNonPhysicsBiasingOperation(
-    const G4Track*, const G4BiasingProcessInterface*)
-  {
-    return 0;
-  }
+    const G4Track* track, const G4BiasingProcessInterface* callingProcess);
 
 private:
   // -- ("using" is to avoid compiler complaining against (false) method shadowing.)
@@ -69,6 +76,11 @@ private:
                                 G4double                 weightForOccurenceInteraction,
                                 G4VBiasingOperation*     finalStateOperationApplied,
                                 const G4VParticleChange* particleChangeProduced);
+  // -- Same, for a non-physics or final state only operation:
+  virtual void OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                                G4BiasingAppliedCase             biasingCase,
+                                G4VBiasingOperation*             operationApplied,
+                                const G4VParticleChange*         particleChangeProduced);
 
 public:
   // -- Optionnal base class method. It is called at the time a tracking of a particle
@@ -78,8 +90,13 @@ public:
 private:
   // -- List of associations between particle types and biasing operators:
   std::map<const G4ParticleDefinition*, WLGDBiasChangeCrossSection*> fBOptrForParticle;
+  std::map<const G4ParticleDefinition*, G4VBiasingOperator*>         fParticleOperators;
   std::vector<const G4ParticleDefinition*>                           fParticlesToBias;
-  WLGDBiasChangeCrossSection*                                        fCurrentOperator;
+  WLGDBiasChangeCrossSection*                                        fCurrentOperator = nullptr;
+  G4VBiasingOperator* fCurrentParticleOperator                                   = nullptr;
+  G4VBiasingOperator*                                                fNonPhysicsOperator = nullptr;
+  G4VBiasingOperator* fCurrentNonPhysicsOperator                                 = nullptr;
+  const WLGDBiasChangeCrossSection::FactorTable*                     fFactorTable = nullptr;
   G4double                                                           fNeutronBias = 1.0;
   G4double                                                           fMuonBias    = 1.0;
   G4double fNeutronYieldBias                                                      = 1.0;
@@ -0,0 +1,51 @@
+#ifndef WLGDBiasSplitOrKillOnBoundary_hh
+#define WLGDBiasSplitOrKillOnBoundary_hh 1
+
+#include "G4ParticleChange.hh"
+#include "G4ParticleChangeForNothing.hh"
+#include "G4VBiasingOperation.hh"
+
+class WLGDBiasImportanceSplitting;
+
+class WLGDBiasSplitOrKillOnBoundary : public G4VBiasingOperation
+{
+public:
+  // -- Constructor: takes the operator providing the volume importances
+  WLGDBiasSplitOrKillOnBoundary(WLGDBiasImportanceSplitting* importances,
+                                G4String name = "SplitOrKillOnBoundary");
+  virtual ~WLGDBiasSplitOrKillOnBoundary() = default;
+
+  // ----------------------------------------------
+  // -- Methods from the base class, not used here:
+  // ----------------------------------------------
+  virtual const G4VBiasingInteractionLaw* ProvideOccurenceBiasingInteractionLaw(
+    const G4BiasingProcessInterface*, G4ForceCondition&)
+  {
+    return 0;
+  }
+  virtual G4VParticleChange* ApplyFinalStateBiasing(const G4BiasingProcessInterface*,
+                                                    const G4Track*, const G4Step*,
+                                                    G4bool&)
+  {
+    return 0;
+  }
+
+  // -----------------------------------------------
+  // -- Methods used for non-physics based biasing:
+  // -----------------------------------------------
+  // -- The operation is forced on every step, and acts only when the step ends
+  // -- on a volume boundary:
+  virtual G4double DistanceToApplyOperation(const G4Track*, G4double,
+                                            G4ForceCondition* condition);
+  // -- Splits the track entering a volume of higher importance, roulettes the
+  // -- track entering a volume of lower importance:
+  virtual G4VParticleChange* GenerateBiasingFinalState(const G4Track* track,
+                                                       const G4Step*  step);
+
+private:
+  WLGDBiasImportanceSplitting* fImportances;
+  G4ParticleChange             fParticleChange;
+  G4ParticleChangeForNothing   fParticleChangeForNothing;
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef WLGDBiasTruncatedExpCapture_hh
+#define WLGDBiasTruncatedExpCapture_hh 1
+
+#include "G4VBiasingOperation.hh"
+
+class G4ILawTruncatedExp;
+
+class WLGDBiasTruncatedExpCapture : public G4VBiasingOperation
+{
+public:
+  // -- Constructor:
+  WLGDBiasTruncatedExpCapture(G4String name = "TruncatedExpCapture");
+  virtual ~WLGDBiasTruncatedExpCapture();
+
+  // -----------------------------------------------
+  // -- Methods used for occurence biasing:
+  // -----------------------------------------------
+  // -- The capture is forced to happen before the given distance, at a point
+  // -- drawn from the analog exponential law truncated there:
+  virtual const G4VBiasingInteractionLaw* ProvideOccurenceBiasingInteractionLaw(
+    const G4BiasingProcessInterface*, G4ForceCondition&);
+  // -- The analog final state is kept, the weight for the occurence is applied
+  // -- by the process interface:
+  virtual G4VParticleChange* ApplyFinalStateBiasing(const G4BiasingProcessInterface*,
+                                                    const G4Track*, const G4Step*,
+                                                    G4bool&)
+  {
+    return 0;
+  }
+
+  // ----------------------------------------------
+  // -- Methods from the base class, not used here:
+  // ----------------------------------------------
+  virtual G4double DistanceToApplyOperation(const G4Track*, G4double, G4ForceCondition*)
+  {
+    return DBL_MAX;
+  }
+  virtual G4VParticleChange* GenerateBiasingFinalState(const G4Track*, const G4Step*)
+  {
+    return 0;
+  }
+
+  // -- Samples the capture point for the analog capture cross section and the
+  // -- distance left to the volume boundary:
+  void Sample(G4double crossSection, G4double maximumDistance);
+
+private:
+  G4ILawTruncatedExp* fTruncatedExpLaw;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef WLGDBiasWeightRoulette_hh
+#define WLGDBiasWeightRoulette_hh 1
+
+#include "G4ParticleChange.hh"
+#include "G4VBiasingOperation.hh"
+
+class WLGDBiasWeightRoulette : public G4VBiasingOperation
+{
+public:
+  // -- Constructor:
+  WLGDBiasWeightRoulette(G4String name = "WeightRoulette");
+  virtual ~WLGDBiasWeightRoulette() = default;
+
+  // ----------------------------------------------
+  // -- Methods from the base class, not used here:
+  // ----------------------------------------------
+  virtual const G4VBiasingInteractionLaw* ProvideOccurenceBiasingInteractionLaw(
+    const G4BiasingProcessInterface*, G4ForceCondition&)
+  {
+    return 0;
+  }
+  virtual G4VParticleChange* ApplyFinalStateBiasing(const G4BiasingProcessInterface*,
+                                                    const G4Track*, const G4Step*,
+                                                    G4bool&)
+  {
+    return 0;
+  }
+
+  // -----------------------------------------------
+  // -- Methods used for non-physics based biasing:
+  // -----------------------------------------------
+  // -- The operation is applied at once, with a step of zero length:
+  virtual G4double DistanceToApplyOperation(const G4Track*, G4double,
+                                            G4ForceCondition* condition);
+  // -- Kills the track, or lets it survive with the survival weight:
+  virtual G4VParticleChange* GenerateBiasingFinalState(const G4Track* track,
+                                                       const G4Step*  step);
+
+  void SetSurvivalWeight(G4double weight) { fSurvivalWeight = weight; }
+
+private:
+  G4double         fSurvivalWeight = 1.;
+  G4ParticleChange fParticleChange;
+};
+
+#endif
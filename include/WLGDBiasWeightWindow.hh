@@ -0,0 +1,89 @@
+#ifndef WLGDBiasWeightWindow_hh
+#define WLGDBiasWeightWindow_hh 1
+
+#include "G4VBiasingOperator.hh"
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class WLGDBiasApplyWeightWindow;
+class WLGDCountAccumulable;
+
+#include <map>
+#include <vector>
+
+#include "G4BiasingProcessInterface.hh"
+
+class WLGDBiasWeightWindow : public G4VBiasingOperator
+{
+public:
+  // -- One line of the weight-window table: a logical volume or region name,
+  // -- an energy group [minEkin, maxEkin) and the weight band of the window
+  struct Window
+  {
+    G4String volume;
+    G4double minEkin        = 0.;
+    G4double maxEkin        = DBL_MAX;
+    G4double lowerWeight    = 0.;
+    G4double upperWeight    = DBL_MAX;
+    G4double survivalWeight = 1.;
+  };
+
+  // -- counters kept per window, in the "WeightWindows" accumulable
+  enum WindowCount
+  {
+    kEntered = 0,
+    kSplitCopies,
+    kRouletteKilled,
+    kRouletteSurvived,
+    kNumberOfWindowCounts
+  };
+  static const char* GetCountName(G4int which);
+
+  // -- Reads a table with one window per line,
+  // --   <volume or region> <Emin/MeV> <Emax/MeV> <wLow> <wUp> [<wSurvive>]
+  // -- where '#' starts a comment and wSurvive defaults to (wLow + wUp) / 2:
+  static std::vector<Window> ReadWindows(const G4String& fileName);
+
+  // ------------------------------------------------------------------------
+  // -- Constructor: takes the name of the particle type to bias and the
+  // -- windows to keep its weight in:
+  // ------------------------------------------------------------------------
+  WLGDBiasWeightWindow(const G4String& particleToBias, const std::vector<Window>& windows,
+                       G4String name = "WeightWindow");
+  virtual ~WLGDBiasWeightWindow();
+
+  // -- method called at beginning of run, resolves the volume and region names:
+  virtual void StartRun();
+
+  // -- Index of the window for a track of kinetic energy ekin in volume, -1 if none:
+  G4int FindWindow(const G4LogicalVolume* volume, G4double ekin) const;
+  const Window& GetWindow(G4int window) const { return fWindows[window]; }
+  void          Count(G4int window, G4int which, G4double value = 1.);
+
+private:
+  // -----------------------------
+  // -- Mandatory from base class:
+  // -----------------------------
+  // -- This method returns the weight-window operation for the particle to bias:
+  virtual G4VBiasingOperation* ProposeNonPhysicsBiasingOperation(
+    const G4Track* track, const G4BiasingProcessInterface* callingProcess);
+  // -- Methods not used:
+  virtual G4VBiasingOperation* ProposeOccurenceBiasingOperation(
+    const G4Track*, const G4BiasingProcessInterface*)
+  {
+    return 0;
+  }
+  virtual G4VBiasingOperation* ProposeFinalStateBiasingOperation(
+    const G4Track*, const G4BiasingProcessInterface*)
+  {
+    return 0;
+  }
+
+private:
+  WLGDBiasApplyWeightWindow*                            fWeightWindowOperation;
+  const G4ParticleDefinition*                           fParticleToBias;
+  std::vector<Window>                                   fWindows;
+  std::map<const G4LogicalVolume*, std::vector<G4int>> fWindowsOfVolume;
+  WLGDCountAccumulable*                                 fCounts = nullptr;
+};
+
+#endif
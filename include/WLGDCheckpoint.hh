@@ -0,0 +1,58 @@
+#ifndef WLGDCheckpoint_h
+#define WLGDCheckpoint_h 1
+
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <map>
+#include <string>
+
+class WLGDPrimaryGeneratorAction;
+
+/// Checkpoints of long production runs, see /WLGD/checkpoint/
+///
+/// /WLGD/checkpoint/beamOn splits the events into runs of the checkpoint
+/// interval. Each run closes its own output shard, <output>_<NNNN>.root, and
+/// is followed by a checkpoint file with the random engine of the master, the
+/// state of the primary generator of each thread (its engine and position in
+/// the MUSUN input) and the counters summed over the finished runs. A job
+/// started with --resume <checkpoint> and the same macro continues after the
+/// last finished run.
+
+class WLGDCheckpoint
+{
+public:
+  explicit WLGDCheckpoint(const G4String& outputFileName);
+  ~WLGDCheckpoint();
+
+  // -- reads the checkpoint of an interrupted job, applied by the next beamOn
+  void Resume(const G4String& fileName);
+  void BeamOn(G4int events);
+
+  // -- shard written by the current checkpointed run, -1 outside of one
+  static G4int GetShard() { return fShard; }
+  // -- called by the run action of each thread at begin and end of run
+  static void RestoreThreadState(WLGDPrimaryGeneratorAction& generator);
+  static void SaveThreadState(WLGDPrimaryGeneratorAction& generator);
+
+private:
+  void DefineCommands();
+  void Write() const;
+
+  G4GenericMessenger* fMessenger = nullptr;
+  G4String            fOutputFileName;
+  G4String            fFileName;          // written after each run
+  G4int               fInterval = 10000;  // events per run
+  // -- progress of the job, from the finished runs or the resumed checkpoint
+  G4bool                       fResumed   = false;
+  G4int                        fEvents    = 0;
+  G4int                        fDone      = 0;
+  G4int                        fNextShard = 0;
+  std::map<G4String, G4double> fCounters;
+  std::string                  fEngineState;
+
+  static std::atomic<G4int> fShard;
+};
+
+#endif
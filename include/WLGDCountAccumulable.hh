@@ -0,0 +1,36 @@
+#ifndef WLGDCountAccumulable_h
+#define WLGDCountAccumulable_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Accumulable holding a list of counters, merged entry by entry
+///
+/// The list grows on demand, so its length only needs to be known on the
+/// threads that fill it; the master picks it up when the workers are merged.
+
+class WLGDCountAccumulable : public G4VAccumulable
+{
+public:
+  explicit WLGDCountAccumulable(const G4String& name);
+  virtual ~WLGDCountAccumulable() = default;
+
+  virtual void Merge(const G4VAccumulable& other);
+  virtual void Reset();
+
+  void Add(std::size_t i, G4double value = 1.)
+  {
+    if(i >= fValues.size())
+      fValues.resize(i + 1, 0.);
+    fValues[i] += value;
+  }
+  G4double    Get(std::size_t i) const { return (i < fValues.size()) ? fValues[i] : 0.; }
+  std::size_t Size() const { return fValues.size(); }
+
+private:
+  std::vector<G4double> fValues;
+};
+
+#endif
@@ -5,8 +5,13 @@
 #include "G4GenericMessenger.hh"
 #include "G4Material.hh"
 #include "G4VUserDetectorConstruction.hh"
+#include "WLGDBiasChangeCrossSection.hh"
+#include "WLGDBiasWeightWindow.hh"
 #include "globals.hh"
 
+#include <map>
+#include <vector>
+
 class G4VPhysicalVolume;
 class WLGDCrystalSD;
 
@@ -42,10 +47,39 @@ public:
   void  SetGeometry(const G4String& name);
   void  ExportGeometry(const G4String& file);
   
-  // -- setter to adjust the cross-section biasing factors
+  // -- setter to adjust the cross-section biasing factors, also between runs
   void  SetNeutronBiasFactor(G4double nf);
   void  SetMuonBiasFactor(G4double mf);
   void  SetNeutronYieldBias(G4double mf);
+  G4double GetNeutronBiasFactor() const { return fBiasFactors.neutronBias; }
+  G4double GetMuonBiasFactor() const { return fBiasFactors.muonBias; }
+
+  // -- per particle, process and volume factors overriding the ones above
+  void  SetBiasFactor(WLGDBiasChangeCrossSection::FactorOverride entry);
+  void  ClearBiasFactors();
+
+  // -- setter for the neutron importance of a logical volume, for splitting
+  // -- and roulette on volume boundaries
+  void  SetImportance(const G4String& volume, G4double importance);
+
+  // -- w/wo forced neutron capture in the germanium crystals (options: [0]:no, 1:yes)
+  void  SetForcedCapture(G4int answer);
+
+  // -- implicit neutron capture (survival biasing) in a logical volume, and the
+  // -- weight floor and survival weight of its roulette
+  void  AddImplicitCapture(const G4String& volume);
+  void  SetImplicitCaptureWeights(G4double weightFloor, G4double survivalWeight);
+
+  // -- strength p in [0, 1) of the neutron exponential transform toward the
+  // -- target point, also between runs once enabled at initialisation
+  void  SetExpTransformStrength(G4double strength);
+
+  // -- reads the neutron weight windows (volume or region x energy group) from file
+  void  SetWeightWindowFile(const G4String& fileName);
+  const std::vector<WLGDBiasWeightWindow::Window>& GetWeightWindows() const
+  {
+    return fWeightWindows;
+  }
 
   // -- setters to adjust the geometry via macros
 
@@ -84,8 +118,22 @@ public:
   void  SetPositionOfDetectors(G4String name);
 
 private:
+  // -- production cut and user limits of a region, negative values are unset,
+  // -- and the neutron cuts handed to its WLGDRegionInformation
+  struct RegionSettings
+  {
+    G4double            productionCut  = -1.;
+    G4double            maxTime        = -1.;
+    G4double            minEkin        = -1.;
+    G4double            minRange       = -1.;
+    G4double            neutronTimeCut = 0.;
+    G4double            neutronEkinCut = 0.;
+    G4GenericMessenger* messenger      = nullptr;
+  };
+
   void DefineCommands();
   void DefineMaterials();
+  void ConstructRegions();
 
   G4VPhysicalVolume* SetupBaseline();
   G4VPhysicalVolume* SetupAlternative();
@@ -94,13 +142,18 @@ private:
   G4GenericMessenger*     fDetectorMessenger       = nullptr;
   G4GenericMessenger*     fBiasMessenger           = nullptr;
   G4GenericMessenger*     fMaterialMessenger       = nullptr;
+  std::map<G4String, RegionSettings> fRegionSettings;
   G4double                fvertexZ                 = -1.0;
   G4double                fmaxrad                  = -1.0;
   G4String                fGeometryName            = "baseline";
   G4String                fDetectorPosition        = "baseline";
-  G4double                fNeutronBias             = 1.0;
-  G4double                fMuonBias                = 1.0;
-  G4double                fNeutronYieldBias        = 1.0;
+  WLGDBiasChangeCrossSection::FactorTable fBiasFactors;
+  std::map<G4String, G4double> fImportances;
+  std::vector<WLGDBiasWeightWindow::Window> fWeightWindows;
+  G4int                   fForcedCapture           = 0;
+  std::vector<G4String>   fImplicitCaptureVolumes;
+  G4double                fImplicitCaptureFloor    = 0.25;
+  G4double                fImplicitCaptureSurvival = 0.5;
   G4Cache<WLGDCrystalSD*> fSD                      = nullptr;
   G4double                fXeConc                  = 0.0;
   G4double                fHe3Conc                 = 0.0;
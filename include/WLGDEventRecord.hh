@@ -0,0 +1,327 @@
+#ifndef WLGDEventRecord_h
+#define WLGDEventRecord_h 1
+
+#include "globals.hh"
+
+#include <array>
+#include <vector>
+
+// -- Columns of the event ntuple, in the order they are written:
+// --   WLGD_COLUMN(id, type, name, unit, size, group)
+// -- type:  kInt or kDouble
+// -- unit:  unit the fill site divides the value by, "" for plain numbers
+// -- size:  0 for a column growing during the event, otherwise the number of
+// --        entries it starts each event with, all 0
+// -- group: switch the column is written under, see WLGDEventRecord::Group
+#define WLGD_EVENT_COLUMNS(WLGD_COLUMN)                                                 \
+  WLGD_COLUMN(kNGe77, kInt, "NGe77", "", 0, kAlways)                                    \
+  WLGD_COLUMN(kHitID, kInt, "HitID", "", 0, kAlways)                                    \
+  WLGD_COLUMN(kHitEdep, kDouble, "Edep", "MeV", 0, kAlways)                             \
+  WLGD_COLUMN(kHitTime, kDouble, "Time", "ns", 0, kAlways)                              \
+  WLGD_COLUMN(kHitWeight, kDouble, "Weight", "", 0, kAlways)                            \
+  WLGD_COLUMN(kHitxLoc, kDouble, "Hitxloc", "m", 0, kAlways)                            \
+  WLGD_COLUMN(kHityLoc, kDouble, "Hityloc", "m", 0, kAlways)                            \
+  WLGD_COLUMN(kHitzLoc, kDouble, "Hitzloc", "m", 0, kAlways)                            \
+  WLGD_COLUMN(kMuonxLoc, kDouble, "Muonxloc", "m", 0, kAlways)                          \
+  WLGD_COLUMN(kMuonyLoc, kDouble, "Muonyloc", "m", 0, kAlways)                          \
+  WLGD_COLUMN(kMuonzLoc, kDouble, "Muonzloc", "m", 0, kAlways)                          \
+  WLGD_COLUMN(kMuonxMom, kDouble, "Muonxmom", "", 0, kAlways)                           \
+  WLGD_COLUMN(kMuonyMom, kDouble, "Muonymom", "", 0, kAlways)                           \
+  WLGD_COLUMN(kMuonzMom, kDouble, "Muonzmom", "", 0, kAlways)                           \
+  WLGD_COLUMN(kMuonEnergy, kDouble, "MuonEnergy", "MeV", 0, kAlways)                    \
+  WLGD_COLUMN(kEkin, kDouble, "Ekin", "eV", 0, kAlways)                                 \
+  WLGD_COLUMN(kReentranceTube, kInt, "ReentranceTube", "", 0, kAlways)                  \
+  WLGD_COLUMN(kDetectorNumber, kInt, "DetectorNumber", "", 0, kAlways)                  \
+  WLGD_COLUMN(kEdepWater_prompt, kDouble, "EdepWater_prompt", "eV", 1, kAlways)         \
+  WLGD_COLUMN(kEdepWater_delayed, kDouble, "EdepWater_delayed", "eV", 1, kAlways)       \
+  WLGD_COLUMN(kMuonVeto_flag, kInt, "MunoVeto", "", 1, kAlways)                         \
+  WLGD_COLUMN(kisIC, kInt, "isIC", "", 1, kAlways)                                      \
+  WLGD_COLUMN(kisMetastable, kInt, "isMetastable", "", 1, kAlways)                      \
+  WLGD_COLUMN(kNeutronxLoc, kDouble, "Neutronxloc", "m", 0, kAlways)                    \
+  WLGD_COLUMN(kNeutronyLoc, kDouble, "Neutronyloc", "m", 0, kAlways)                    \
+  WLGD_COLUMN(kNeutronzLoc, kDouble, "Neutronzloc", "m", 0, kAlways)                    \
+  WLGD_COLUMN(kNeutronxMom, kDouble, "Neutronxmom", "", 0, kAlways)                     \
+  WLGD_COLUMN(kNeutronyMom, kDouble, "Neutronymom", "", 0, kAlways)                     \
+  WLGD_COLUMN(kNeutronzMom, kDouble, "Neutronzmom", "", 0, kAlways)                     \
+  WLGD_COLUMN(kNeutronTime, kDouble, "NeutronTime", "", 0, kAlways)                     \
+  WLGD_COLUMN(kNeutronEkin, kDouble, "NeutronEkin", "eV", 0, kAlways)                   \
+  WLGD_COLUMN(kNeutronID, kDouble, "NeutronID", "", 0, kAlways)                         \
+  WLGD_COLUMN(kNeutronEventID, kDouble, "NeutronEventID", "", 0, kAlways)               \
+  WLGD_COLUMN(kNeutronVolume, kDouble, "NeutronVolume", "", 0, kAlways)                 \
+  WLGD_COLUMN(kNeutronsInEvent, kInt, "NeutronsInEvent", "", 1, kAlways)                \
+  WLGD_COLUMN(kNeutronsMostOuterRadius, kDouble, "NeutronsMostOuterRadius", "m", 0,     \
+              kAlways)                                                                  \
+  WLGD_COLUMN(kLArEnergyDeposition, kDouble, "LArEnergyDeposition", "eV", 4, kAlways)   \
+  WLGD_COLUMN(kGeEnergyDeposition, kDouble, "GeEnergyDeposition", "eV", 4, kAlways)     \
+  WLGD_COLUMN(kLArEnergyDeposition_delayed, kDouble, "LArEnergyDeposition_delayed",     \
+              "eV", 4, kAlways)                                                         \
+  WLGD_COLUMN(kGeEnergyDeposition_delayed, kDouble, "GeEnergyDeposition_delayed", "eV", \
+              4, kAlways)                                                               \
+  WLGD_COLUMN(kLArEnergyDeposition_delayed_long, kDouble,                               \
+              "LArEnergyDeposition_delayed_long", "eV", 4, kAdvancedMultiplicity)       \
+  WLGD_COLUMN(kGeEnergyDeposition_delayed_long, kDouble,                                \
+              "GeEnergyDeposition_delayed_long", "eV", 4, kAdvancedMultiplicity)        \
+  WLGD_COLUMN(kLArEnergyDeposition_after_delayed, kDouble,                              \
+              "LArEnergyDeposition_after_delayed", "eV", 4, kAdvancedMultiplicity)      \
+  WLGD_COLUMN(kGeEnergyDeposition_after_delayed, kDouble,                               \
+              "GeEnergyDeposition_after_delayed", "eV", 4, kAdvancedMultiplicity)       \
+  WLGD_COLUMN(kIndividualEnergyDeposition_Timing, kDouble,                              \
+              "IndividualEnergyDeposition_Timing", "us", 0, kAlways)                    \
+  WLGD_COLUMN(kIndividualEnergyDeposition_Energy, kDouble,                              \
+              "IndividualEnergyDeposition_Energy", "eV", 0, kAlways)                    \
+  WLGD_COLUMN(kIndividualEnergyDeposition_Position_x, kDouble,                          \
+              "IndividualEnergyDeposition_Position_x", "m", 0, kAlways)                 \
+  WLGD_COLUMN(kIndividualEnergyDeposition_Position_y, kDouble,                          \
+              "IndividualEnergyDeposition_Position_y", "m", 0, kAlways)                 \
+  WLGD_COLUMN(kIndividualEnergyDeposition_Position_z, kDouble,                          \
+              "IndividualEnergyDeposition_Position_z", "m", 0, kAlways)                 \
+  WLGD_COLUMN(kIndividualEnergyDeposition_ReentranceTube, kInt,                         \
+              "IndividualEnergyDeposition_ReentranceTube", "", 0, kAlways)              \
+  WLGD_COLUMN(kIndividualEnergyDeposition_LArOrGe, kInt,                                \
+              "IndividualEnergyDeposition_Volume", "", 0, kAlways)                      \
+  WLGD_COLUMN(kIndividualEnergyDeposition_ID, kInt, "IndividualEnergyDeposition_ID",    \
+              "", 0, kAlways)                                                           \
+  WLGD_COLUMN(kIndividualEnergyDeposition_Type, kInt,                                   \
+              "IndividualEnergyDeposition_Type", "", 0, kAlways)                        \
+  WLGD_COLUMN(kIndividualEnergyDeposition_DetectorNumber, kInt,                         \
+              "IndividualEnergyDeposition_DetectorNumber", "", 0, kAlways)              \
+  WLGD_COLUMN(kMultiplicity_prompt, kInt, "Multiplicity_prompt", "", 4, kAlways)        \
+  WLGD_COLUMN(kMultiplicity_delayed, kInt, "Multiplicity_delayed", "", 4, kAlways)      \
+  WLGD_COLUMN(kMultiplicity_delayed_long, kInt, "Multiplicity_delayed_long", "", 4,     \
+              kAdvancedMultiplicity)                                                    \
+  WLGD_COLUMN(kEdepPerDetector_prompt, kDouble, "EdepPerDetector_prompt", "eV", 0,      \
+              kAlways)                                                                  \
+  WLGD_COLUMN(kEdepPerDetector_delayed, kDouble, "EdepPerDetector_delayed", "eV", 0,    \
+              kAlways)                                                                  \
+  WLGD_COLUMN(kEdepPerDetector_delayed_long, kDouble, "EdepPerDetector_delayed_long",   \
+              "eV", 0, kAdvancedMultiplicity)                                           \
+  WLGD_COLUMN(kNDetector_prompt, kDouble, "CopyNDetector_prompt", "", 0, kAlways)       \
+  WLGD_COLUMN(kNDetector_delayed, kDouble, "CopyNDetector_delayed", "", 0, kAlways)     \
+  WLGD_COLUMN(kNDetector_delayed_long, kDouble, "CopyNDetector_delayed_long", "", 0,    \
+              kAdvancedMultiplicity)                                                    \
+  WLGD_COLUMN(kEdepPerDetector_prompt_woGd, kDouble, "EdepPerDetector_prompt_woGd",     \
+              "eV", 0, kAdvancedMultiplicity)                                           \
+  WLGD_COLUMN(kEdepPerDetector_delayed_woGd, kDouble, "EdepPerDetector_delayed_woGd",   \
+              "eV", 0, kAdvancedMultiplicity)                                           \
+  WLGD_COLUMN(kNDetector_prompt_woGd, kDouble, "CopyNDetector_prompt_woGd", "", 0,      \
+              kAdvancedMultiplicity)                                                    \
+  WLGD_COLUMN(kNDetector_delayed_woGd, kDouble, "CopyNDetector_delayed_woGd", "", 0,    \
+              kAdvancedMultiplicity)                                                    \
+  WLGD_COLUMN(kEdepPerDetector_prompt_onlyGd, kDouble, "EdepPerDetector_prompt_onlyGd", \
+              "eV", 0, kAdvancedMultiplicity)                                           \
+  WLGD_COLUMN(kEdepPerDetector_delayed_onlyGd, kDouble,                                 \
+              "EdepPerDetector_delayed_onlyGd", "eV", 0, kAdvancedMultiplicity)         \
+  WLGD_COLUMN(kNDetector_prompt_onlyGd, kDouble, "CopyNDetector_prompt_onlyGd", "", 0,  \
+              kAdvancedMultiplicity)                                                    \
+  WLGD_COLUMN(kNDetector_delayed_onlyGd, kDouble, "CopyNDetector_delayed_onlyGd", "",   \
+              0, kAdvancedMultiplicity)                                                 \
+  WLGD_COLUMN(kGe77Siblings_timing, kDouble, "Ge77Siblings_timing", "s", 0,             \
+              kIndividualGe)                                                            \
+  WLGD_COLUMN(kGe77Siblings_x, kDouble, "Ge77Siblings_x", "m", 0, kIndividualGe)        \
+  WLGD_COLUMN(kGe77Siblings_y, kDouble, "Ge77Siblings_y", "m", 0, kIndividualGe)        \
+  WLGD_COLUMN(kGe77Siblings_z, kDouble, "Ge77Siblings_z", "m", 0, kIndividualGe)        \
+  WLGD_COLUMN(kGe77Siblings_edep, kDouble, "Ge77Siblings_edep", "eV", 0, kIndividualGe) \
+  WLGD_COLUMN(kGe77Siblings_id, kInt, "Ge77Siblings_id", "", 0, kIndividualGe)          \
+  WLGD_COLUMN(kGe77Siblings_type, kInt, "Ge77Siblings_type", "", 0, kIndividualGe)      \
+  WLGD_COLUMN(kGe77Siblings_whichVolume, kInt, "Ge77Siblings_whichVolume", "", 0,       \
+              kIndividualGe)                                                            \
+  WLGD_COLUMN(kNeutronCaptureSiblings_type, kInt, "NeutronCaptureSiblings_type", "", 0, \
+              kAlways)                                                                  \
+  WLGD_COLUMN(kNeutronCaptureSiblings_edep, kDouble, "NeutronCaptureSiblings_edep",     \
+              "eV", 0, kAlways)                                                         \
+  WLGD_COLUMN(kGdSiblings_timing, kDouble, "GdSiblings_timing", "s", 0, kIndividualGd)  \
+  WLGD_COLUMN(kGdSiblings_x, kDouble, "GdSiblings_x", "m", 0, kIndividualGd)            \
+  WLGD_COLUMN(kGdSiblings_y, kDouble, "GdSiblings_y", "m", 0, kIndividualGd)            \
+  WLGD_COLUMN(kGdSiblings_z, kDouble, "GdSiblings_z", "m", 0, kIndividualGd)            \
+  WLGD_COLUMN(kGdSiblings_edep, kDouble, "GdSiblings_edep", "eV", 0, kIndividualGd)     \
+  WLGD_COLUMN(kGdSiblings_id, kInt, "GdSiblings_id", "", 0, kIndividualGd)              \
+  WLGD_COLUMN(kGdSiblings_type, kInt, "GdSiblings_type", "", 0, kIndividualGd)          \
+  WLGD_COLUMN(kGdSiblings_whichVolume, kInt, "GdSiblings_whichVolume", "", 0,           \
+              kIndividualGd)                                                            \
+  WLGD_COLUMN(knCOther_timing, kDouble, "nCapture_timing", "s", 0, kAlways)             \
+  WLGD_COLUMN(knCOther_x, kDouble, "nCapture_x", "m", 0, kAlways)                       \
+  WLGD_COLUMN(knCOther_y, kDouble, "nCapture_y", "m", 0, kAlways)                       \
+  WLGD_COLUMN(knCOther_z, kDouble, "nCapture_z", "m", 0, kAlways)                       \
+  WLGD_COLUMN(knCOther_A, kInt, "nCapture_A", "", 0, kAlways)                           \
+  WLGD_COLUMN(knCOther_ZC, kInt, "nCapture_Z", "", 0, kAlways)                          \
+  WLGD_COLUMN(knCOther_ID, kInt, "nCapture_ID", "", 0, kAlways)                         \
+  WLGD_COLUMN(knCOther_EventID, kInt, "nCapture_EventID", "", 0, kAlways)               \
+  WLGD_COLUMN(knCOther_Volume, kInt, "nCapture_Volume", "", 0, kAlways)                 \
+  WLGD_COLUMN(kprod_timing, kDouble, "prod_timing", "s", 0, kAlways)                    \
+  WLGD_COLUMN(kprod_x, kDouble, "prod_x", "m", 0, kAlways)                              \
+  WLGD_COLUMN(kprod_y, kDouble, "prod_y", "m", 0, kAlways)                              \
+  WLGD_COLUMN(kprod_z, kDouble, "prod_z", "m", 0, kAlways)                              \
+  WLGD_COLUMN(kprod_A, kInt, "prod_A", "", 0, kAlways)                                  \
+  WLGD_COLUMN(kprod_ZC, kInt, "prod_Z", "", 0, kAlways)                                 \
+  WLGD_COLUMN(kprod_parentType, kInt, "prod_parentType", "", 0, kAlways)                \
+  WLGD_COLUMN(kGe77mGammaEmission_timing, kDouble, "Ge77mGammaEmission_timing", "s", 0, \
+              kIndividualGe)                                                            \
+  WLGD_COLUMN(kGe77mGammaEmission_x, kDouble, "Ge77mGammaEmission_x", "m", 0,           \
+              kIndividualGe)                                                            \
+  WLGD_COLUMN(kGe77mGammaEmission_y, kDouble, "Ge77mGammaEmission_y", "m", 0,           \
+              kIndividualGe)                                                            \
+  WLGD_COLUMN(kGe77mGammaEmission_z, kDouble, "Ge77mGammaEmission_z", "m", 0,           \
+              kIndividualGe)                                                            \
+  WLGD_COLUMN(kGe77mGammaEmission_edep, kDouble, "Ge77mGammaEmission_edep", "eV", 0,    \
+              kIndividualGe)                                                            \
+  WLGD_COLUMN(kGe77mGammaEmission_id, kInt, "Ge77mGammaEmission_id", "", 0,             \
+              kIndividualGe)                                                            \
+  WLGD_COLUMN(kGe77mGammaEmission_type, kInt, "Ge77mGammaEmission_type", "", 0,         \
+              kIndividualGe)                                                            \
+  WLGD_COLUMN(kGe77mGammaEmission_whichVolume, kInt, "Ge77mGammaEmission_whichVolume",  \
+              "", 0, kIndividualGe)                                                     \
+  WLGD_COLUMN(kGe77mGammaEmission_whichGe77, kInt, "Ge77mGammaEmission_whichGe77", "",  \
+              0, kIndividualGe)                                                         \
+  WLGD_COLUMN(kTrjPDG, kInt, "Trjpdg", "", 0, kAlways)                                  \
+  WLGD_COLUMN(kTrjEntries, kInt, "Trjentries", "", 0, kAlways)                          \
+  WLGD_COLUMN(kNameID, kInt, "VtxName", "", 0, kAlways)                                 \
+  WLGD_COLUMN(kTrjXVtx, kDouble, "TrjXVtx", "mm", 0, kAlways)                           \
+  WLGD_COLUMN(kTrjYVtx, kDouble, "TrjYVtx", "mm", 0, kAlways)                           \
+  WLGD_COLUMN(kTrjZVtx, kDouble, "TrjZVtx", "mm", 0, kAlways)                           \
+  WLGD_COLUMN(kTrjXPos, kDouble, "TrjXPos", "mm", 0, kAlways)                           \
+  WLGD_COLUMN(kTrjYPos, kDouble, "TrjYPos", "mm", 0, kAlways)                           \
+  WLGD_COLUMN(kTrjZPos, kDouble, "TrjZPos", "mm", 0, kAlways)                           \
+  WLGD_COLUMN(kMuon_WLSR_intersect_x, kDouble, "Muon_WLSR_intersect_x", "m", 0,         \
+              kAlways)                                                                  \
+  WLGD_COLUMN(kMuon_WLSR_intersect_y, kDouble, "Muon_WLSR_intersect_y", "m", 0,         \
+              kAlways)                                                                  \
+  WLGD_COLUMN(kMuon_WLSR_intersect_z, kDouble, "Muon_WLSR_intersect_z", "m", 0,         \
+              kAlways)                                                                  \
+  WLGD_COLUMN(kMuon_WLSR_Edep, kDouble, "Muon_WLSR_Edep", "eV", 1, kAlways)
+
+/// Per-thread record of the event ntuple
+///
+/// Every column is declared once in WLGD_EVENT_COLUMNS. Book() creates the
+/// ntuple with the columns of the enabled groups and allocates their storage,
+/// one vector per column; the columns of disabled groups get neither storage
+/// nor a branch, and filling them is a no-op.
+
+class WLGDEventRecord
+{
+public:
+  enum Column
+  {
+#define WLGD_COLUMN_ID(id, type, name, unit, size, group) id,
+    WLGD_EVENT_COLUMNS(WLGD_COLUMN_ID)
+#undef WLGD_COLUMN_ID
+    kNumberOfColumns
+  };
+
+  enum Type
+  {
+    kInt,
+    kDouble
+  };
+
+  // -- switches of the run action the columns are written under
+  enum Group
+  {
+    kAlways,
+    kAdvancedMultiplicity,
+    kIndividualGe,
+    kIndividualGd,
+    kNumberOfGroups
+  };
+
+  WLGDEventRecord();
+  ~WLGDEventRecord() = default;
+
+  // -- only before Allocate(), the layout is fixed from then on
+  void EnableGroup(Group group, G4bool enable);
+  // -- sizes the storage of the enabled columns without booking them, copies
+  // -- of an allocated record share its layout
+  void   Allocate();
+  G4bool IsAllocated() const { return fAllocated; }
+  // -- creates the ntuple with the enabled columns, in the order of the schema
+  void   Book(const G4String& name, const G4String& title);
+  G4bool IsBooked() const { return fBooked; }
+  G4int  GetNtupleID() const { return fNtupleID; }
+  // -- exchanges the column contents with a record of the same layout; the
+  // -- vectors keep their addresses, so a booked record stays booked
+  void Swap(WLGDEventRecord& other);
+  // -- empties the growing columns and sets the fixed-size ones to 0
+  void Reset();
+  // -- lists the schema with the columns booked on this thread
+  void Print() const;
+
+  G4bool IsEnabled(Column column) const { return fSlots[column].index >= 0; }
+
+  void Add(Column column, G4double value)
+  {
+    const Slot& slot = fSlots[column];
+    if(slot.index < 0)
+      return;
+    if(slot.type == kInt)
+      fIntColumns[slot.index].push_back((G4int) value);
+    else
+      fDoubleColumns[slot.index].push_back(value);
+  }
+  void Set(Column column, std::size_t i, G4double value)
+  {
+    const Slot& slot = fSlots[column];
+    if(slot.index < 0)
+      return;
+    if(slot.type == kInt)
+      fIntColumns[slot.index][i] = (G4int) value;
+    else
+      fDoubleColumns[slot.index][i] = value;
+  }
+  void Increase(Column column, std::size_t i, G4double value)
+  {
+    const Slot& slot = fSlots[column];
+    if(slot.index < 0)
+      return;
+    if(slot.type == kInt)
+      fIntColumns[slot.index][i] += (G4int) value;
+    else
+      fDoubleColumns[slot.index][i] += value;
+  }
+  // -- 0 for a column that is not booked
+  G4double Get(Column column, std::size_t i) const
+  {
+    const Slot& slot = fSlots[column];
+    if(slot.index < 0)
+      return 0.;
+    return (slot.type == kInt) ? fIntColumns[slot.index][i]
+                               : fDoubleColumns[slot.index][i];
+  }
+  std::size_t Size(Column column) const
+  {
+    const Slot& slot = fSlots[column];
+    if(slot.index < 0)
+      return 0;
+    return (slot.type == kInt) ? fIntColumns[slot.index].size()
+                               : fDoubleColumns[slot.index].size();
+  }
+
+private:
+  struct ColumnInfo
+  {
+    const char* name;
+    const char* unit;
+    std::size_t size;
+    Type        type;
+    Group       group;
+  };
+  static const ColumnInfo& GetInfo(G4int column);
+
+  struct Slot
+  {
+    G4int index = -1;  // into the storage of its type, -1 if not booked
+    Type  type  = kDouble;
+  };
+
+  std::array<Slot, kNumberOfColumns>  fSlots;
+  std::array<G4bool, kNumberOfGroups> fGroupEnabled;
+  // -- the ntuple keeps the address of each vector, so the outer vectors are
+  // -- sized once in Allocate() and never grow again
+  std::vector<std::vector<G4int>>    fIntColumns;
+  std::vector<std::vector<G4double>> fDoubleColumns;
+  std::vector<std::size_t>           fIntSizes;
+  std::vector<std::size_t>           fDoubleSizes;
+  G4bool                             fAllocated = false;
+  G4bool                             fBooked    = false;
+  G4int                              fNtupleID  = -1;
+};
+
+#endif
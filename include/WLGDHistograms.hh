@@ -0,0 +1,109 @@
+#ifndef WLGDHistograms_h
+#define WLGDHistograms_h 1
+
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+#include <array>
+#include <istream>
+#include <vector>
+
+/// Run-level histograms of event, neutron capture and Ge-77 quantities
+///
+/// The histograms are defined by /WLGD/histo/ commands, booked with the
+/// event ntuple at the first run and filled from the event and tracking
+/// actions on each thread; Geant4 merges them on the master, which
+/// writes them to its output file. The event ntuple itself may be turned
+/// off for studies that only need the distributions.
+
+class WLGDHistograms
+{
+public:
+  // -- where the quantities of a histogram come from; the axes of one
+  // -- histogram have a single source
+  enum Source
+  {
+    kEvent,    // end of event: the quantities of WLGDSkim, weight 1
+    kCapture,  // neutron capture, at the weight of the neutron
+    kGe77,     // neutron capture producing Ge-77, at the weight of the neutron
+    kNumberOfSources
+  };
+  // -- quantities of the capture and Ge-77 sources, lengths in m, time in us
+  enum Point
+  {
+    kX,
+    kY,
+    kZ,
+    kR,
+    kTime,
+    kA,
+    kZC,
+    kEkin,  // of the neutron, in eV
+    kNumberOfPointQuantities
+  };
+
+  // -- "<name> <quantity> <bins> <min> <max>" with up to three axes, as
+  // -- given to /WLGD/histo/add
+  struct Definition
+  {
+    G4String              name;
+    std::vector<G4String> quantities;
+    std::vector<G4int>    bins;
+    std::vector<G4double> min;
+    std::vector<G4double> max;
+  };
+
+  WLGDHistograms();
+  ~WLGDHistograms();
+
+  // -- books the defined histograms on the calling thread, once
+  void   Book();
+  G4bool IsBooked() const { return fBooked; }
+  G4bool HasHistograms(Source source) const { return !fBySource[source].empty(); }
+  G4bool WriteNtuples() const { return fWriteNtuples != 0; }
+
+  // -- fills the histograms of the source from its quantities
+  void Fill(Source source, const G4double* values, G4double weight) const;
+
+private:
+  struct Histogram
+  {
+    Definition         definition;
+    Source             source;
+    std::vector<G4int> quantities;  // index into the values of the source
+    G4int              id = -1;
+  };
+
+  void DefineCommands();
+  void Add(Definition definition);
+  void Clear();
+  void List();
+  // -- source and index of "<source>.<quantity>", false if unknown
+  static G4bool FindQuantity(const G4String& name, Source& source, G4int& quantity);
+
+  G4GenericMessenger*    fMessenger = nullptr;
+  std::vector<Histogram> fHistograms;
+  // -- indices into fHistograms, by source
+  std::array<std::vector<std::size_t>, kNumberOfSources> fBySource;
+  G4int                                                  fWriteNtuples = 1;
+  G4bool                                                 fBooked       = false;
+};
+
+// -- reads up to three "<quantity> <bins> <min> <max>" axes after the name
+inline std::istream& operator>>(std::istream& in, WLGDHistograms::Definition& definition)
+{
+  in >> definition.name;
+  G4String quantity;
+  G4int    bins;
+  G4double min, max;
+  while(definition.quantities.size() < 3 && in >> quantity >> bins >> min >> max)
+  {
+    definition.quantities.push_back(quantity);
+    definition.bins.push_back(bins);
+    definition.min.push_back(min);
+    definition.max.push_back(max);
+  }
+  return in;
+}
+
+#endif
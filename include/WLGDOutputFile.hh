@@ -0,0 +1,76 @@
+#ifndef WLGDOutputFile_h
+#define WLGDOutputFile_h 1
+
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+#include <vector>
+
+/// Compression, basket and shard settings of the ROOT output, see /WLGD/output/
+///
+/// Geant4 writes its ROOT files with zlib only. The level and basket size
+/// are passed to the analysis manager; another algorithm is applied by
+/// rewriting the closed file with ROOT, which also gives the bytes written
+/// per column for the end of run report. The run action rotates the file of
+/// each thread into a new shard once it holds the events or bytes of the shard
+/// limit; the shards of all threads are listed in a manifest.
+
+class WLGDOutputFile
+{
+public:
+  // -- a line of the manifest, <output>.manifest
+  struct Shard
+  {
+    G4String file;
+    G4int    run;
+    G4int    shard;
+    G4int    thread;
+    G4int    firstEvent;
+    G4int    lastEvent;
+    G4int    events;
+  };
+
+  WLGDOutputFile();
+  ~WLGDOutputFile();
+
+  // -- applies the level and basket size, before the file is opened
+  void Configure() const;
+  // -- after the file is closed: applies the algorithm and prints the report
+  void Finish(const G4String& fileName) const;
+
+  // -- name of the file written by this thread for the given output name,
+  // -- empty if its rows are merged into the file of the master
+  static G4String GetThreadFileName(const G4String& name, G4bool merged);
+  // -- output name of the shard with the given sequence number, <name>_<NNNN>.root,
+  // -- the name itself for a negative number
+  static G4String GetShardFileName(const G4String& name, G4int shard);
+
+  // -- whether the file of this thread is rotated, and if the shard written to
+  // -- the given file is full with the given events
+  G4bool IsSharded() const { return fShardEvents > 0 || fShardBytes > 0.; }
+  G4bool IsShardFull(G4int events, const G4String& fileName) const;
+
+  // -- shards closed on any thread, appended to the manifest by the master at
+  // -- the end of run
+  static void AddShard(const Shard& shard);
+  static void WriteManifest(const G4String& name);
+
+private:
+  void DefineCommands();
+  // -- ROOT compression settings, 100 * algorithm + level
+  G4int GetCompressionSettings() const;
+  void  Recompress(const G4String& fileName) const;
+  void  Report(const G4String& fileName) const;
+  // -- "<N> [events]" or "<size> kB|MB|GB", 0 for a single file per run
+  void SetShardEvery(const G4String& limit);
+
+  G4GenericMessenger* fMessenger   = nullptr;
+  G4String            fAlgorithm   = "ZLIB";
+  G4int               fLevel       = 1;      // the Geant4 default
+  G4int               fBasketSize  = 32000;  // the Geant4 default, in bytes
+  G4int               fReport      = 0;
+  G4int               fShardEvents = 0;      // events of this thread per shard
+  G4double            fShardBytes  = 0.;     // size of its file per shard, in bytes
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef WLGDOutputWriter_h
+#define WLGDOutputWriter_h 1
+
+#include "WLGDEventRecord.hh"
+#include "globals.hh"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class G4VAnalysisManager;
+
+/// Writer thread filling the event ntuple of one worker thread
+///
+/// The worker hands each completed event over by swapping the columns of its
+/// record into a free record of a fixed pool, so no column is copied; the
+/// writer swaps them into the booked record and adds the ntuple row, where
+/// ROOT serialises and compresses. When the pool is used up the worker waits
+/// for the writer. The analysis manager of the worker is only driven by the
+/// writer between Start() and Drain().
+
+class WLGDOutputWriter
+{
+public:
+  // -- takes the layout of an allocated record, with room for depth events
+  WLGDOutputWriter(const WLGDEventRecord& layout, std::size_t depth);
+  ~WLGDOutputWriter();
+
+  // -- books the ntuple on the calling thread, with the columns of the layout
+  void Book(const G4String& name, const G4String& title);
+
+  // -- starts the writer thread, once the output file is open
+  void Start();
+  // -- queues the event in the record, which gets back emptied storage to be
+  // -- reset; waits while all records of the pool are queued
+  void Push(WLGDEventRecord& record);
+  // -- writes the queued events and stops the writer thread, before the
+  // -- output file is written and closed
+  void Drain();
+
+  // -- for other rows added on the worker thread while the writer runs
+  std::unique_lock<std::mutex> LockAnalysisManager()
+  {
+    return std::unique_lock<std::mutex>(fAnalysisMutex);
+  }
+
+  // -- events written and hand-overs that had to wait, since the last Start()
+  G4int GetNumberOfRows() const { return fRows; }
+  G4int GetNumberOfWaits() const { return fWaits; }
+
+private:
+  void Run();
+
+  G4VAnalysisManager*           fAnalysisManager;
+  WLGDEventRecord               fBooked;
+  std::vector<WLGDEventRecord>  fPool;
+  std::deque<WLGDEventRecord*>  fFree;
+  std::deque<WLGDEventRecord*>  fQueued;
+  std::mutex                    fMutex;
+  std::mutex                    fAnalysisMutex;
+  std::condition_variable       fFreeCondition;
+  std::condition_variable       fQueuedCondition;
+  std::thread                   fThread;
+  G4bool                        fStop  = false;
+  G4int                         fRows  = 0;
+  G4int                         fWaits = 0;
+};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef WLGDPilotRun_h
+#define WLGDPilotRun_h 1
+
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class WLGDDetectorConstruction;
+
+/// Pilot runs to tune the cross-section bias factors
+///
+/// Runs a short batch of events at each point of a grid of neutron and muon
+/// bias factors, compares the figure of merit of the weighted Ge-77 yield
+/// reported by the master run action, and writes the best factors as a
+/// macro fragment for the production jobs to include.
+
+class WLGDPilotRun
+{
+public:
+  explicit WLGDPilotRun(WLGDDetectorConstruction* detector);
+  ~WLGDPilotRun();
+
+  void AddNeutronBias(G4double factor) { fNeutronGrid.push_back(factor); }
+  void AddMuonBias(G4double factor) { fMuonGrid.push_back(factor); }
+  void ClearGrid();
+  void Run();
+
+private:
+  void DefineCommands();
+
+  WLGDDetectorConstruction* fDetector;
+  G4GenericMessenger*       fMessenger   = nullptr;
+  std::vector<G4double>     fNeutronGrid;
+  std::vector<G4double>     fMuonGrid;
+  G4int                     fEvents      = 100;
+  G4String                  fOutputMacro = "pilot-bias.mac";
+};
+
+#endif
@@ -4,6 +4,7 @@
 // std c++ includes
 #include <cmath>
 #include <fstream>
+#include <iostream>
 #include <random>
 
 #include "G4GenericMessenger.hh"
@@ -112,6 +113,11 @@ public:
   void OpenMUSUNDirectory(G4String pathtodata);
   void shortcutToChangeFileName(const G4String& newFile);
 
+  // -- state of the generator for a checkpoint: its random engine and the file
+  // -- and position of the MUSUN input, on one line
+  void SaveState(std::ostream& out);
+  void RestoreState(std::istream& in);
+
   
 private:
   void DefineCommands();
@@ -127,6 +133,7 @@ private:
   G4String           fGenerator;
   std::ifstream      fInputFile;
   G4String           fFileName;
+  G4String           fOpenedFile;  // MUSUN input currently read
   G4double           fZShift;
 
   std::vector<G4String> ListOfMUSUNFiles;
@@ -0,0 +1,45 @@
+#ifndef WLGDRegionInformation_h
+#define WLGDRegionInformation_h 1
+
+#include "G4VUserRegionInformation.hh"
+#include "globals.hh"
+
+/// Region information class
+///
+/// Attached to the regions of WLGDDetectorConstruction, it tells the user
+/// actions the role of a region and holds the neutron cuts applied in it.
+
+class WLGDRegionInformation : public G4VUserRegionInformation
+{
+public:
+  enum Role
+  {
+    kWorld = 0,
+    kRock,
+    kHall,
+    kWater,
+    kCryostat,
+    kInner,
+    kNumberOfRoles
+  };
+
+  explicit WLGDRegionInformation(Role role);
+  virtual ~WLGDRegionInformation() = default;
+
+  virtual void Print() const;
+
+  Role     GetRole() const { return fRole; }
+  G4double GetNeutronTimeCut() const { return fNeutronTimeCut; }
+  G4double GetNeutronEkinCut() const { return fNeutronEkinCut; }
+  void     SetNeutronTimeCut(G4double t) { fNeutronTimeCut = t; }
+  void     SetNeutronEkinCut(G4double e) { fNeutronEkinCut = e; }
+
+  static const char* GetRoleName(G4int role);
+
+private:
+  Role     fRole;
+  G4double fNeutronTimeCut;
+  G4double fNeutronEkinCut = 0.;
+};
+
+#endif
@@ -1,15 +1,26 @@
 #ifndef WLGDRunAction_h
 #define WLGDRunAction_h 1
 
+#include "G4Accumulable.hh"
 #include "G4GenericMessenger.hh"
+#include "G4ThreeVector.hh"
 #include "G4UserRunAction.hh"
+#include "WLGDCountAccumulable.hh"
+#include "WLGDHistograms.hh"
+#include "WLGDOutputFile.hh"
+#include "WLGDRegionInformation.hh"
 #include "globals.hh"
 
+class WLGDDetectorConstruction;
 class WLGDEventAction;
+class WLGDOutputWriter;
+class WLGDPrimaryGeneratorAction;
 class G4Run;
 
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <vector>
 using namespace std;
 /// Run action class
@@ -18,7 +29,8 @@ using namespace std;
 class WLGDRunAction : public G4UserRunAction
 {
 public:
-  WLGDRunAction(WLGDEventAction* eventAction, G4String name);
+  WLGDRunAction(WLGDEventAction* eventAction, G4String name,
+                WLGDDetectorConstruction* detector);
   virtual ~WLGDRunAction();
 
   virtual void BeginOfRunAction(const G4Run*);
@@ -28,32 +40,67 @@ public:
   void         increaseTotalNumberOfNeutronsInLAr() { fTotalNumberOfNeutronsInLAr++; }
   G4int        getNumberOfNeutronsInLAr() { return fTotalNumberOfNeutronsInLAr; }
 
-  // -- some redudant output for the production of neutrons inside the cryostat (not only Ge77 producing) should be removed in the future
-  void         addEventNumber(G4int i)
-  {
-    vector_eventNumber.push_back(i);
-  }  
-  void addCoordinatsToFile(G4double x, G4double y, G4double z)
+  // -- neutron produced in the event, written to the NeutronProduction ntuple at
+  // -- the end of the event; position in m, ekin in eV
+  void addNeutronProduction(G4int eventID, const G4ThreeVector& position,
+                            const G4ThreeVector& direction, G4double ekin,
+                            G4int parentPDG);
+  // -- called at the end of each event, so only one event is held in memory
+  void WriteNeutronProductions();
+
+  // -- neutrons killed by the region cuts, per WLGDRegionInformation::Role
+  void addKilledNeutron(G4int role, G4bool byTime)
   {
-    vector_x_dir.push_back(x);
-    vector_y_dir.push_back(y);
-    vector_z_dir.push_back(z);
-  } 
-  void addMomentumToFile(G4double x, G4double y, G4double z)
+    fKilledNeutrons.Add(2 * role + (byTime ? 0 : 1));
+  }
+
+  // -- decisions of the stacking policy, per WLGDStackingAction::Decision and role
+  void addStackDecision(G4int decision, G4int role)
   {
-    vector_x_mom.push_back(x);
-    vector_y_mom.push_back(y);
-    vector_z_mom.push_back(z);
-  }  
-  void addEnergyToFile(G4double ekin)
+    fStackDecisions.Add(decision * WLGDRegionInformation::kNumberOfRoles + role);
+  }
+
+  // -- events processed and aborted early, per WLGDStackingAction::EventCount
+  void addEventCount(G4int which) { fEventCounts.Add(which); }
+
+  // -- events tested by the skim, written, and passing each condition
+  void addSkimResult(G4bool written, const std::vector<G4bool>& passed)
   {
-    vector_energy.push_back(ekin);
-  } 
-  void addParentParticleType(G4int PDG_code)
+    fSkimCounts.Add(0);
+    if(written)
+      fSkimCounts.Add(1);
+    for(std::size_t i = 0; i < passed.size(); ++i)
+    {
+      if(passed[i])
+        fSkimCounts.Add(2 + i);
+    }
+  }
+
+  // -- weighted Ge-77 score of one event, for the yield and its variance
+  void addGe77Score(G4double score);
+
+  // -- figure of merit 1 / (R^2 T) of the weighted Ge-77 yield of the last run,
+  // -- with R its relative error and T the thread time of the event loops
+  // -- summed over the workers; valid on the master
+  G4double GetFigureOfMerit() const { return fFigureOfMerit; }
+  G4double GetRelativeError() const { return fRelativeError; }
+  // -- merged counters of the last run by name, valid on the master; summed over
+  // -- the runs of a checkpointed job by WLGDCheckpoint
+  std::map<G4String, G4double> GetRunCounters() const;
+
+  // -- at the end of each event, before its rows are added: rotates the output
+  // -- of this thread into a new shard once the current one is full
+  void CountShardEvent(G4int eventID);
+
+  // -- the generator of this thread, its state is kept by checkpoints
+  void SetPrimaryGenerator(WLGDPrimaryGeneratorAction* generator)
   {
-    vector_parentParticleType.push_back(PDG_code);
+    fPrimaryGenerator = generator;
   }
-  
+
+  // -- /WLGD/histo/ histograms of this thread, filled by the event and tracking actions
+  const WLGDHistograms& GetHistograms() const { return fHistograms; }
+
   G4int getWriteOutNeutronProductionInfo() { return fWriteOutNeutronProductionInfo; }
   G4int getWriteOutGeneralNeutronInfo() { return fWriteOutGeneralNeutronInfo; }
   G4int getWriteOutAdvancedMultiplicity() { return fWriteOutAdvancedMultiplicity; }
@@ -65,15 +112,31 @@ public:
 
 private:
   void DefineCommands();
+  // -- from the accumulated scores and the given time, by default the merged one
+  void UpdateFigureOfMerit(G4double cpuTime = -1.);
+  void PrintFigureOfMerit(const G4String& when) const;
+  // -- /WLGD/output/shardEvery: the Shard ntuple and the file rotation
+  void BookShardNtuple();
+  void CloseShard();
+  void RotateShard();
 
 private:
   G4GenericMessenger*   fMessenger;
   WLGDEventAction*      fEventAction;  // have event information for run
+  WLGDDetectorConstruction* fDetector;  // weight windows to label their counters
   G4String              fout;          // output file name
+  G4String              fRunFileName;  // output of the run, per checkpoint shard
+  G4String              fFileName;     // file open on this thread, shard of the run
+  G4bool                fSharded         = false;  // fixed at the first run
+  G4int                 fShardID         = -1;
+  G4int                 fRunID           = 0;
+  G4int                 fShard           = 0;
+  G4int                 fShardEvents     = 0;
+  G4int                 fShardFirstEvent = 0;
+  G4int                 fShardLastEvent  = 0;
+  WLGDPrimaryGeneratorAction* fPrimaryGenerator = nullptr;  // none on the master
   G4int                 fNumberOfCrossingNeutrons;
   G4int                 fTotalNumberOfNeutronsInLAr;
-  G4String              fout2, fout3;
-  ofstream              outputStream_2;
   G4int                 fWriteOutNeutronProductionInfo = 0;
   G4int                 fWriteOutGeneralNeutronInfo    = 0;
   G4int                 fWriteOutAdvancedMultiplicity  = 0;
@@ -82,15 +145,44 @@ private:
   G4int                 fIndividualGdDepositionInfo    = 0;
   G4int                 fReadMuonCrossingWLSR          = 0;
   G4int                 fNeutronCaptureSiblings        = 0;
-  std::vector<G4int>    vector_eventNumber;
-  std::vector<G4double> vector_x_dir;
-  std::vector<G4double> vector_y_dir;
-  std::vector<G4double> vector_z_dir;
-  std::vector<G4double> vector_x_mom;
-  std::vector<G4double> vector_y_mom;
-  std::vector<G4double> vector_z_mom;
-  std::vector<G4double> vector_energy;
-  std::vector<G4int>    vector_parentParticleType;
+  G4int                 fMergeNtuples                  = 0;
+  G4int                 fOutputQueueDepth              = 0;
+  std::unique_ptr<WLGDOutputWriter> fOutputWriter;
+  WLGDOutputFile        fOutputFile;  // /WLGD/output/ settings of this thread
+  WLGDHistograms        fHistograms;  // /WLGD/histo/ histograms of this thread
+  WLGDCountAccumulable  fKilledNeutrons{ "KilledNeutrons" };
+  WLGDCountAccumulable  fStackDecisions{ "StackDecisions" };
+  WLGDCountAccumulable  fEventCounts{ "EventCounts" };
+  WLGDCountAccumulable  fSkimCounts{ "SkimCounts" };
+  // -- per window and WLGDBiasWeightWindow::WindowCount, filled by the operator
+  WLGDCountAccumulable  fWeightWindowCounts{ "WeightWindows" };
+  // -- per WLGDBiasImportanceSplitting::SplitCount, filled by the operator
+  WLGDCountAccumulable  fImportanceCounts{ "ImportanceSplitting" };
+  // -- per WLGDBiasForcedCapture::CaptureCount, filled by the operator
+  WLGDCountAccumulable  fForcedCaptureCounts{ "ForcedCapture" };
+  // -- per WLGDBiasImplicitCapture::RouletteCount, filled by the operator
+  WLGDCountAccumulable  fImplicitCaptureCounts{ "ImplicitCapture" };
+  G4Accumulable<G4double> fGe77Yield{ "Ge77Yield", 0. };
+  G4Accumulable<G4double> fGe77YieldSquared{ "Ge77YieldSquared", 0. };
+  G4Accumulable<G4int>    fScoredEvents{ "ScoredEvents", 0 };
+  G4Accumulable<G4double> fCPUTime{ "CPUTime", 0. };
+  G4double              fRunCPUStart = 0.;  // thread CPU time at start of run
+  G4int                 fFOMReportInterval = 0;
+  G4double              fFOMCPUTime    = 0.;
+  G4double              fFigureOfMerit = 0.;
+  G4double              fRelativeError = 0.;
+  struct NeutronProduction
+  {
+    G4int         eventID;
+    G4ThreeVector position;
+    G4ThreeVector direction;
+    G4double      ekin;
+    G4int         parentPDG;
+  };
+  std::vector<NeutronProduction> fNeutronProductions;
+  G4int                 fNeutronProductionID = -1;
+  G4int                 fRunSummaryID        = -1;
+  void                  BookNeutronNtuples();
   void                  SetWriteOutNeutronProductionInfo(G4int answer);
   void                  SetWriteOutGeneralNeutronInfo(G4int answer);
   void                  SetWriteOutAdvancedMultiplicity(G4int answer);
@@ -99,6 +191,11 @@ private:
   void                  SetIndividualGdDepositionInfo(G4int answer);
   void                  SetReadMuonCrossingWLSR(G4int answer);
   void                  SetNeutronCaptureSiblings(G4int answer);
+  void                  SetMergeNtuples(G4int answer);
+  void                  SetOutputQueueDepth(G4int depth);
+  // -- warns and returns false once the event ntuple is booked
+  G4bool                CheckBeforeBooking(const G4String& command) const;
+  void                  PrintColumns();
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
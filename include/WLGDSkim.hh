@@ -0,0 +1,93 @@
+#ifndef WLGDSkim_h
+#define WLGDSkim_h 1
+
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+#include <array>
+#include <istream>
+#include <vector>
+
+/// Event skim: conditions on quantities of the event, see /WLGD/skim/
+///
+/// The event action computes the quantities at the end of each event it
+/// would write and only writes it when the conditions pass, all of them or
+/// any of them. Without conditions every such event passes.
+
+class WLGDSkim
+{
+public:
+  enum Quantity
+  {
+    kHits,
+    kNGe77,
+    kMultiplicityPrompt,
+    kMultiplicityDelayed,
+    kMultiplicityDelayedLong,
+    kGeEnergyPrompt,
+    kGeEnergyDelayed,
+    kLArEnergyPrompt,
+    kLArEnergyDelayed,
+    kWaterEnergyPrompt,
+    kWaterEnergyDelayed,
+    kMuonVeto,
+    kNeutrons,
+    kNumberOfQuantities
+  };
+  // -- energies in keV
+  using Values = std::array<G4double, kNumberOfQuantities>;
+
+  // -- "<quantity> <comparison> <value>", as given to /WLGD/skim/add
+  struct Condition
+  {
+    G4String quantity;
+    G4String comparison;
+    G4double value = 0.;
+  };
+
+  WLGDSkim();
+  ~WLGDSkim();
+
+  G4bool IsActive() const { return !fPredicates.empty(); }
+  // -- tests every condition, so each has its pass count, and combines them
+  G4bool Evaluate(const Values& values, std::vector<G4bool>& passed) const;
+
+  std::size_t     GetNumberOfPredicates() const { return fPredicates.size(); }
+  const G4String& GetPredicateName(std::size_t i) const { return fPredicates[i].name; }
+
+  static const char* GetQuantityName(G4int quantity);
+
+private:
+  enum Comparison
+  {
+    kGreater,
+    kGreaterEqual,
+    kLess,
+    kLessEqual,
+    kEqual,
+    kNotEqual
+  };
+  struct Predicate
+  {
+    G4String   name;
+    Quantity   quantity;
+    Comparison comparison;
+    G4double   value;
+  };
+
+  void DefineCommands();
+  void AddPredicate(Condition condition);
+  void ClearPredicates() { fPredicates.clear(); }
+  void List();
+
+  G4GenericMessenger*    fMessenger = nullptr;
+  std::vector<Predicate> fPredicates;
+  G4String               fMode = "all";
+};
+
+inline std::istream& operator>>(std::istream& in, WLGDSkim::Condition& condition)
+{
+  return in >> condition.quantity >> condition.comparison >> condition.value;
+}
+
+#endif
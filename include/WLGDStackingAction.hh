@@ -1,22 +1,92 @@
 #ifndef WLGDStackingAction_H
 #define WLGDStackingAction_H 1
 
+#include "G4GenericMessenger.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
 #include "G4Track.hh"
 #include "G4UserStackingAction.hh"
+#include "WLGDRegionInformation.hh"
 #include "globals.hh"
 
+#include <array>
+#include <set>
+
+class WLGDEventAction;
+class WLGDRunAction;
+
+/// Stacking action class
+///
+/// Applies a kill / Russian roulette policy to low-energy e- and gamma per
+/// region role (see WLGDRegionInformation) and can defer particle types to a
+/// later stage. Without any policy set, every track is classified fWaiting.
+/// The roulette is only offered outside the Water, Cryostat and Inner regions,
+/// since the read-out energy deposits do not carry the track weight.
+///
+/// At each stage boundary the tracks waiting for the next stage are checked;
+/// if none of them can still lead to Ge-77 the event is aborted early.
+
 class WLGDStackingAction : public G4UserStackingAction
 {
 public:
-  WLGDStackingAction()          = default;
-  virtual ~WLGDStackingAction() = default;
+  // -- decisions counted by the run action
+  enum Decision
+  {
+    kKilled = 0,
+    kRouletteKilled,
+    kRouletteSurvived,
+    kDeferred,
+    kNumberOfDecisions
+  };
+
+  // -- event counts kept by the run action for normalisation
+  enum EventCount
+  {
+    kEventsProcessed = 0,
+    kEventsAborted
+  };
+
+  WLGDStackingAction(WLGDEventAction* event, WLGDRunAction* run);
+  virtual ~WLGDStackingAction();
 
 public:
   virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* aTrack);
   virtual void                       NewStage();
   virtual void                       PrepareNewEvent();
 
+  void DeferParticle(const G4String& name);
+  void ClearDeferredParticles();
+
+  static const char* GetDecisionName(G4int decision);
+
 private:
+  // -- policy of one region role, negative energies are unset
+  struct RolePolicy
+  {
+    G4double            killEnergy          = -1.;
+    G4double            rouletteEnergy      = -1.;
+    G4double            rouletteProbability = 1.;
+    G4GenericMessenger* messenger           = nullptr;
+  };
+
+  void DefineCommands();
+  // -- can a waiting track still lead to Ge-77 production
+  G4bool IsGe77Candidate(const G4Track* aTrack) const;
+
+  WLGDEventAction*                      fEventAction;
+  WLGDRunAction*                        fRunAction;
+  G4GenericMessenger*                   fStackMessenger = nullptr;
+  std::array<RolePolicy, WLGDRegionInformation::kNumberOfRoles> fPolicy;
+  std::set<const G4ParticleDefinition*> fDeferredParticles;
+
+  // -- early abort of events without Ge-77 candidates
+  G4int         fEarlyAbort        = 0;
+  G4int         fAbortMinimumStage = 1;
+  G4double      fAbortRadius       = 5. * CLHEP::m;
+  G4ThreeVector fAbortCentre;
+  G4double      fAbortEMThreshold = 5. * CLHEP::MeV;
+  G4int         fStage            = 0;
+  G4int         fWaitingCandidates = 0;
 };
 
 #endif
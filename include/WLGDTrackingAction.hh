@@ -6,6 +6,10 @@
 #include "WLGDRunAction.hh"
 #include <map>
 
+class G4LogicalVolume;
+class G4ProcessManager;
+class G4VProcess;
+
 class WLGDTrackingAction : public G4UserTrackingAction
 {
 public:
@@ -22,6 +26,13 @@ public:
   virtual void PostUserTrackingAction(const G4Track*);
 
 private:
+  void                     ResolveProcesses();
+  static const G4VProcess* FindProcess(const G4ProcessManager* manager,
+                                       const G4String&         name);
+  static G4int             VolumeIndex(const G4LogicalVolume* volume);
+
+  G4bool            fProcessesResolved = false;
+  const G4VProcess* fCaptureProcess    = nullptr;
   double           tmp_neutronXpos, tmp_neutronYpos, tmp_neutronZpos;
   double           tmp_neutronXmom, tmp_neutronYmom, tmp_neutronZmom;
   double           tmp_neutronTime;
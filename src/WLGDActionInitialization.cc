@@ -18,7 +18,7 @@ WLGDActionInitialization::~WLGDActionInitialization() = default;
 void WLGDActionInitialization::BuildForMaster() const
 {
   auto event = new WLGDEventAction;
-  SetUserAction(new WLGDRunAction(event, foutname));
+  SetUserAction(new WLGDRunAction(event, foutname, fDet));
 }
 
 void WLGDActionInitialization::Build() const
@@ -28,12 +28,15 @@ void WLGDActionInitialization::Build() const
   // added connection between the event action and run/tracking/stepping action classes
   // added connection between run action and tracking/stepping action class
   // Yeah, I know its not pretty but for my first G4 project, I think it's ok. Sorry for the mess. If you have any problems, just write me on Slack
-  SetUserAction(new WLGDPrimaryGeneratorAction(fDet));
+  auto generator = new WLGDPrimaryGeneratorAction(fDet);
+  SetUserAction(generator);
   auto event = new WLGDEventAction();
   SetUserAction(event);
-  auto run = new WLGDRunAction(event, foutname);
+  auto run = new WLGDRunAction(event, foutname, fDet);
   SetUserAction(run);
+  event->SetRunAction(run);
+  run->SetPrimaryGenerator(generator);
   SetUserAction(new WLGDTrackingAction(event, run));
   SetUserAction(new WLGDSteppingAction(event, run, fDet));
-  SetUserAction(new WLGDStackingAction);
+  SetUserAction(new WLGDStackingAction(event, run));
 }
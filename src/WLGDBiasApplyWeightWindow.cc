@@ -0,0 +1,100 @@
+// -- weight-window splitting and Russian roulette on volume boundaries
+
+#include "WLGDBiasApplyWeightWindow.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "Randomize.hh"
+#include "WLGDBiasWeightWindow.hh"
+
+#include <cmath>
+
+WLGDBiasApplyWeightWindow::WLGDBiasApplyWeightWindow(WLGDBiasWeightWindow* windows,
+                                                     G4String              name)
+: G4VBiasingOperation(std::move(name))
+, fWindows(windows)
+{}
+
+G4double WLGDBiasApplyWeightWindow::DistanceToApplyOperation(
+  const G4Track*, G4double, G4ForceCondition* condition)
+{
+  // -- return "infinite" distance for interaction, but asks for GenerateBiasingFinalState
+  // -- being called anyway at the end of the step, so that the boundary can be checked:
+  *condition = Forced;
+  return DBL_MAX;
+}
+
+G4VParticleChange* WLGDBiasApplyWeightWindow::GenerateBiasingFinalState(
+  const G4Track* track, const G4Step* step)
+{
+  fParticleChangeForNothing.Initialize(*track);
+
+  // -- act only when the step is limited by a volume boundary, and not on the
+  // -- first step of a track, which may start on a boundary it was cloned at:
+  if(step->GetPostStepPoint()->GetStepStatus() != fGeomBoundary ||
+     track->GetCurrentStepNumber() == 1)
+  {
+    return &fParticleChangeForNothing;
+  }
+
+  // -- a track leaving the world has no next volume:
+  const G4VPhysicalVolume* postVolume = step->GetPostStepPoint()->GetPhysicalVolume();
+  if(postVolume == nullptr)
+  {
+    return &fParticleChangeForNothing;
+  }
+
+  G4int window =
+    fWindows->FindWindow(postVolume->GetLogicalVolume(), track->GetKineticEnergy());
+  if(window < 0)
+  {
+    return &fParticleChangeForNothing;
+  }
+  fWindows->Count(window, WLGDBiasWeightWindow::kEntered);
+
+  const WLGDBiasWeightWindow::Window& bounds = fWindows->GetWindow(window);
+  G4double                            weight = track->GetWeight();
+
+  if(weight > bounds.upperWeight)
+  {
+    // -- split into as many copies as needed to bring each below the upper bound:
+    auto nCopies = static_cast<G4int>(std::ceil(weight / bounds.upperWeight));
+    if(nCopies > kMaxSplit)
+    {
+      nCopies = kMaxSplit;
+    }
+    G4double splitWeight = weight / nCopies;
+    fParticleChange.Initialize(*track);
+    fParticleChange.ProposeParentWeight(splitWeight);
+    fParticleChange.SetSecondaryWeightByProcess(true);
+    fParticleChange.SetNumberOfSecondaries(nCopies - 1);
+    for(G4int i = 1; i < nCopies; ++i)
+    {
+      auto* clone = new G4Track(*track);
+      clone->SetWeight(splitWeight);
+      fParticleChange.AddSecondary(clone);
+    }
+    fWindows->Count(window, WLGDBiasWeightWindow::kSplitCopies, nCopies - 1);
+    return &fParticleChange;
+  }
+
+  if(weight < bounds.lowerWeight)
+  {
+    // -- Russian roulette: survive at the survival weight, with the probability
+    // -- that conserves the expected weight:
+    fParticleChange.Initialize(*track);
+    if(G4UniformRand() * bounds.survivalWeight < weight)
+    {
+      fParticleChange.ProposeParentWeight(bounds.survivalWeight);
+      fWindows->Count(window, WLGDBiasWeightWindow::kRouletteSurvived);
+    }
+    else
+    {
+      fParticleChange.ProposeTrackStatus(fStopAndKill);
+      fWindows->Count(window, WLGDBiasWeightWindow::kRouletteKilled);
+    }
+    return &fParticleChange;
+  }
+
+  return &fParticleChangeForNothing;
+}
@@ -1,5 +1,10 @@
 #include "WLGDBiasChangeCrossSection.hh"
 
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+
+#include <algorithm>
+
 WLGDBiasChangeCrossSection::WLGDBiasChangeCrossSection(G4String particleToBias,
                                                        G4String name)
 : G4VBiasingOperator(std::move(name))
@@ -16,9 +21,9 @@ WLGDBiasChangeCrossSection::WLGDBiasChangeCrossSection(G4String particleToBias,
 }
 
 WLGDBiasChangeCrossSection::~WLGDBiasChangeCrossSection(){
-    for(auto& it : fChangeCrossSectionOperations)
+    for(auto* operation : fChangeCrossSectionOperations)
     {
-        delete it.second;
+        delete operation;
     }
 }
 
@@ -40,15 +45,97 @@ void WLGDBiasChangeCrossSection::StartRun(){
         {
             for(const auto* wrapperProcess : sharedData->GetPhysicsBiasingProcessInterfaces())
             {
-                //G4cout << "XSchange-" << wrapperProcess->GetWrappedProcess()->GetProcessName() << G4endl;
                 G4String operationName =
                         "XSchange-" + wrapperProcess->GetWrappedProcess()->GetProcessName();
-                fChangeCrossSectionOperations[wrapperProcess] =
-                        new G4BOptnChangeCrossSection(operationName);
+                fProcesses.push_back(wrapperProcess);
+                fChangeCrossSectionOperations.push_back(
+                        new G4BOptnChangeCrossSection(operationName));
             }
         }
         fSetup = false;
     }
+
+    if(fFactorTable != nullptr)
+    {
+        fNeutronBias      = fFactorTable->neutronBias;
+        fMuonBias         = fFactorTable->muonBias;
+        fNeutronYieldBias = fFactorTable->neutronYieldBias;
+        if(fpname == "neutron")
+        {
+            fTransformStrength = fFactorTable->transformStrength;
+            fTransformTarget   = fFactorTable->transformTarget;
+        }
+    }
+
+    // -- Resolve the factor of every (process slot, logical volume) pair once, so
+    // -- that the per-step lookup is an array read. Volumes are indexed by their
+    // -- instance ID, which is unique over the logical volume store:
+    const G4LogicalVolumeStore* volumeStore = G4LogicalVolumeStore::GetInstance();
+    fNumberOfVolumeIDs = 0;
+    for(const G4LogicalVolume* volume : *volumeStore)
+    {
+        fNumberOfVolumeIDs = std::max(fNumberOfVolumeIDs, volume->GetInstanceID() + 1);
+    }
+    fFactors.assign(fProcesses.size() * fNumberOfVolumeIDs, 1.0);
+    for(std::size_t slot = 0; slot < fProcesses.size(); ++slot)
+    {
+        const G4String& processName = fProcesses[slot]->GetWrappedProcess()->GetProcessName();
+        for(const G4LogicalVolume* volume : *volumeStore)
+        {
+            fFactors[slot * fNumberOfVolumeIDs + volume->GetInstanceID()] =
+                    ComputeFactor(processName, volume);
+        }
+    }
+}
+
+G4double WLGDBiasChangeCrossSection::ComputeFactor(const G4String& processName,
+                                                   const G4LogicalVolume* volume) const{
+    G4double factor = fOverridesOnly ? 1.0 : DefaultFactor(processName, volume);
+    if(fFactorTable != nullptr)
+    {
+        for(const auto& entry : fFactorTable->overrides)
+        {
+            if((entry.particle == "*" || entry.particle == fpname) &&
+               (entry.process == "*" || entry.process == processName) &&
+               (entry.volume == "*" || entry.volume == volume->GetName()))
+            {
+                factor = entry.factor;
+            }
+        }
+    }
+    return factor;
+}
+
+G4double WLGDBiasChangeCrossSection::DefaultFactor(const G4String& processName,
+                                                   const G4LogicalVolume* volume) const{
+    // -- Choose a constant cross-section bias. But at this level, this factor can be made
+    // -- direction dependent, like in the exponential transform MCNP case, or it
+    // -- can be chosen differently, depending on the process, etc.
+    // -- Processes not listed here are left analog.
+    if(fpname == "mu-")
+    {
+        if(processName == "muonNuclear")
+            return fMuonBias;  // configurable cross section boost factor
+        if(processName == "muMinusCaptureAtRest")
+            return fNeutronYieldBias;
+        return 1.0;
+    }
+    if(fpname == "neutron")
+    {
+        if(processName == "nCapture")
+        {
+            if(volume->GetName() == "Ge_log")
+                return fNeutronBias * 1.68;  // specific for this, boost n,gamma by 68% for 77Ge from 76Ge
+            return fNeutronBias;
+        }
+        if(processName == "neutronInelastic")
+            return fNeutronYieldBias;
+        return 1.0;
+    }
+    if(fpname == "gamma" || fpname == "pi+" || fpname == "pi-" || fpname == "proton" ||
+       fpname == "kaon-")
+        return fNeutronYieldBias;
+    return 1.0;
 }
 
 G4VBiasingOperation* WLGDBiasChangeCrossSection::ProposeOccurenceBiasingOperation(
@@ -61,6 +148,38 @@ G4VBiasingOperation* WLGDBiasChangeCrossSection::ProposeOccurenceBiasingOperatio
         return nullptr;
     }
 
+    // -- find the slot of the calling process, there are only a few of them:
+    std::size_t slot = 0;
+    while(slot < fProcesses.size() && fProcesses[slot] != callingProcess)
+    {
+        ++slot;
+    }
+    if(slot == fProcesses.size())
+    {
+        return nullptr;
+    }
+
+    // -- a factor of one is left to the analog process:
+    G4double XStransformation =
+            fFactors[slot * fNumberOfVolumeIDs +
+                     track->GetVolume()->GetLogicalVolume()->GetInstanceID()];
+    if(fTransformStrength != 0.)
+    {
+        // -- exponential transform: paths are stretched toward the target and
+        // -- shortened away from it, the direction being taken at the step start
+        G4ThreeVector toTarget = fTransformTarget - track->GetPosition();
+        G4double      mu       = 0.;
+        if(toTarget.mag2() > 0.)
+        {
+            mu = track->GetMomentumDirection().dot(toTarget.unit());
+        }
+        XStransformation *= 1. - fTransformStrength * mu;
+    }
+    if(XStransformation == 1.0)
+    {
+        return nullptr;
+    }
+
     // ---------------------------------------------------------------------
     // -- select and setup the biasing operation for current callingProcess:
     // ---------------------------------------------------------------------
@@ -78,46 +197,8 @@ G4VBiasingOperation* WLGDBiasChangeCrossSection::ProposeOccurenceBiasingOperatio
     // -- Analog cross-section is well-defined:
     G4double analogXS = 1. / analogInteractionLength;
 
-    // -- Choose a constant cross-section bias. But at this level, this factor can be made
-    // -- direction dependent, like in the exponential transform MCNP case, or it
-    // -- can be chosen differently, depending on the process, etc.
-    G4double XStransformation;
-    // G4cout << " >>> ChangeCrossSection: got muon bias " << fMuonBias
-    //        << ", n factor " << fNeutronBias << G4endl;
-    if(track->GetParticleDefinition()->GetParticleName() == "mu-")//fpname.contains("mu-"))
-    {
-        if(callingProcess->GetWrappedProcess()->GetProcessName() == "muonNuclear")
-            XStransformation = fMuonBias;  // configurable cross section boost factor
-        if(callingProcess->GetWrappedProcess()->GetProcessName() == "muMinusCaptureAtRest")
-            XStransformation = fNeutronYieldBias;
-    }
-    else{
-        if(track->GetParticleDefinition()->GetParticleName() == "neutron")
-        {
-            if(callingProcess->GetWrappedProcess()->GetProcessName() == "nCapture"){
-                if(track->GetStep()->GetPostStepPoint()
-                           ->GetTouchable()
-                           ->GetVolume(0)
-                           ->GetLogicalVolume()
-                           ->GetName() == "Ge_log")
-                    XStransformation = fNeutronBias * 1.68;  // specific for this, boost n,gamma by 68% for 77Ge from 76Ge
-                else
-                    XStransformation = fNeutronBias;
-            }
-            if(callingProcess->GetWrappedProcess()->GetProcessName() == "neutronInelastic"){
-                XStransformation = fNeutronYieldBias;
-            }
-        }
-        else if(track->GetParticleDefinition()->GetParticleName() == "gamma")  {XStransformation = fNeutronYieldBias;}
-        else if(track->GetParticleDefinition()->GetParticleName() == "pi+")    {XStransformation = fNeutronYieldBias;}
-        else if(track->GetParticleDefinition()->GetParticleName() == "pi-")    {XStransformation = fNeutronYieldBias;}
-        else if(track->GetParticleDefinition()->GetParticleName() == "proton") {XStransformation = fNeutronYieldBias;}
-        else if(track->GetParticleDefinition()->GetParticleName() == "kaon-")  {XStransformation = fNeutronYieldBias;}
-        else { XStransformation = 1.0;}
-    }
-    //G4cout << "XStransformation: " << XStransformation << " | " << fpname << " - " << callingProcess->GetWrappedProcess()->GetProcessName() << " - " << XStransformation * analogXS << G4endl;
     // -- fetch the operation associated to this callingProcess:
-    G4BOptnChangeCrossSection* operation = fChangeCrossSectionOperations[callingProcess];
+    G4BOptnChangeCrossSection* operation = fChangeCrossSectionOperations[slot];
     // -- get the operation that was proposed to the process in the previous step:
     G4VBiasingOperation* previousOperation =
             callingProcess->GetPreviousOccurenceBiasingOperation();
@@ -179,9 +260,15 @@ void WLGDBiasChangeCrossSection::OperationApplied(
         const G4BiasingProcessInterface* callingProcess, G4BiasingAppliedCase /*unused*/,
         G4VBiasingOperation*             occurenceOperationApplied, G4double /*unused*/,
         G4VBiasingOperation* /*unused*/, const G4VParticleChange* /*unused*/){
-    G4BOptnChangeCrossSection* operation = fChangeCrossSectionOperations[callingProcess];
-    if(operation == occurenceOperationApplied)
+    for(std::size_t slot = 0; slot < fProcesses.size(); ++slot)
     {
-        operation->SetInteractionOccured();
+        if(fProcesses[slot] == callingProcess)
+        {
+            if(fChangeCrossSectionOperations[slot] == occurenceOperationApplied)
+            {
+                fChangeCrossSectionOperations[slot]->SetInteractionOccured();
+            }
+            return;
+        }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,224 @@
+// -- forced collision restricted to the capture process, following the
+// -- G4BOptrForceCollision operator used in examples/GB02: the particle entering
+// -- the volume is cloned, the clone is forced to be captured before leaving it
+// -- and carries the analog capture probability along the chord as weight, the
+// -- original continues uncollided, with its weight reduced by the analog
+// -- probability of not being captured
+
+#include "WLGDBiasForcedCapture.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4BOptnChangeCrossSection.hh"
+#include "G4BOptnCloning.hh"
+#include "G4LogicalVolume.hh"
+#include "G4NavigationHistory.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4PhysicsModelCatalog.hh"
+#include "G4VAuxiliaryTrackInformation.hh"
+#include "G4VSolid.hh"
+#include "G4VTouchable.hh"
+#include "WLGDBiasTruncatedExpCapture.hh"
+#include "WLGDCountAccumulable.hh"
+#include "geomdefs.hh"
+
+#include <algorithm>
+
+namespace
+{
+  // -- flags the clone produced at the volume entry:
+  class WLGDForcedCaptureClone : public G4VAuxiliaryTrackInformation
+  {};
+}  // namespace
+
+WLGDBiasForcedCapture::WLGDBiasForcedCapture(const G4String& particleToBias,
+                                             G4String captureProcess, G4String name)
+: G4VBiasingOperator(std::move(name))
+, fCaptureProcessName(std::move(captureProcess))
+{
+  fCloningOperation       = new G4BOptnCloning("Cloning");
+  fNoCaptureOperation     = new G4BOptnChangeCrossSection("NoCapture");
+  fForcedCaptureOperation = new WLGDBiasTruncatedExpCapture("ForcedCapture");
+  fCloneModelID = G4PhysicsModelCatalog::Register("WLGDForcedCaptureClone");
+  fParticleToBias = G4ParticleTable::GetParticleTable()->FindParticle(particleToBias);
+
+  if(fParticleToBias == nullptr)
+  {
+    G4ExceptionDescription ed;
+    ed << "Particle `" << particleToBias << "' not found !" << G4endl;
+    G4Exception("WLGDBiasForcedCapture(...)", "exWLGD.06", JustWarning, ed);
+  }
+}
+
+WLGDBiasForcedCapture::~WLGDBiasForcedCapture()
+{
+  delete fCloningOperation;
+  delete fNoCaptureOperation;
+  delete fForcedCaptureOperation;
+  for(auto& entry : fNoInteractionOperations)
+  {
+    delete entry.second;
+  }
+}
+
+void WLGDBiasForcedCapture::StartRun()
+{
+  // -- the counters are registered by the run action, on master and workers alike:
+  fCounts = dynamic_cast<WLGDCountAccumulable*>(
+    G4AccumulableManager::Instance()->GetAccumulable("ForcedCapture", false));
+
+  if(fParticleToBias == nullptr || fCaptureProcess != nullptr)
+  {
+    return;
+  }
+
+  const G4BiasingProcessSharedData* sharedData =
+    G4BiasingProcessInterface::GetSharedData(fParticleToBias->GetProcessManager());
+  if(sharedData != nullptr)
+  {
+    for(const auto* wrapperProcess : sharedData->GetPhysicsBiasingProcessInterfaces())
+    {
+      const G4String& processName = wrapperProcess->GetWrappedProcess()->GetProcessName();
+      if(processName == fCaptureProcessName)
+      {
+        fCaptureProcess = wrapperProcess;
+      }
+      // -- elastic scattering does not end the branch, it stays analog:
+      else if(processName != "hadElastic")
+      {
+        fNoInteractionOperations[wrapperProcess] =
+          new G4BOptnChangeCrossSection("NoInteraction-" + processName);
+      }
+    }
+  }
+
+  if(fCaptureProcess == nullptr)
+  {
+    G4ExceptionDescription ed;
+    ed << "Process `" << fCaptureProcessName << "' of `"
+       << fParticleToBias->GetParticleName()
+       << "' is not under biasing, no capture is forced." << G4endl;
+    G4Exception("WLGDBiasForcedCapture::StartRun()", "exWLGD.07", JustWarning, ed);
+  }
+}
+
+void WLGDBiasForcedCapture::StartTracking(const G4Track* track)
+{
+  fState = (track->GetAuxiliaryTrackInformation(fCloneModelID) != nullptr) ? kForced
+                                                                           : kAnalog;
+}
+
+G4VBiasingOperation* WLGDBiasForcedCapture::ProposeNonPhysicsBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* /*unused*/)
+{
+  if(track->GetDefinition() != fParticleToBias || fCaptureProcess == nullptr ||
+     fState == kForced)
+  {
+    return nullptr;
+  }
+
+  // -- clone on entering the volume, or on the first step of a particle
+  // -- starting inside it (e.g. a copy made by splitting on the boundary):
+  if(track->GetStep()->GetPreStepPoint()->GetStepStatus() != fGeomBoundary &&
+     track->GetCurrentStepNumber() != 1)
+  {
+    return nullptr;
+  }
+
+  // -- both copies start with the full weight, the capture probability is
+  // -- applied along the steps:
+  fCloningOperation->SetCloneWeights(track->GetWeight(), track->GetWeight());
+  fState = kUncollided;
+  return fCloningOperation;
+}
+
+G4VBiasingOperation* WLGDBiasForcedCapture::ProposeOccurenceBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* callingProcess)
+{
+  if(track->GetDefinition() != fParticleToBias || fState == kAnalog)
+  {
+    return nullptr;
+  }
+
+  // -- the uncollided particle is never captured, the other processes stay
+  // -- analog; a capture cross-section of zero makes the weight follow the
+  // -- analog probability of not being captured:
+  if(fState == kUncollided)
+  {
+    if(callingProcess != fCaptureProcess)
+    {
+      return nullptr;
+    }
+    fNoCaptureOperation->SetBiasedCrossSection(0.);
+    fNoCaptureOperation->Sample();
+    return fNoCaptureOperation;
+  }
+
+  // -- the clone can only end with a capture: processes ending it otherwise
+  // -- are forbidden, as their outcome is carried by the uncollided particle
+  if(callingProcess != fCaptureProcess)
+  {
+    auto it = fNoInteractionOperations.find(callingProcess);
+    if(it == fNoInteractionOperations.end())
+    {
+      return nullptr;
+    }
+    it->second->SetBiasedCrossSection(0.);
+    it->second->Sample();
+    return it->second;
+  }
+
+  G4double analogInteractionLength =
+    callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+  if(analogInteractionLength > DBL_MAX / 10.)
+  {
+    return nullptr;
+  }
+
+  // -- the capture point is drawn again on every step over the distance left to
+  // -- the boundary, as elastic scattering may have changed the direction:
+  const G4VTouchable* touchable = track->GetTouchable();
+  G4ThreeVector       localPosition =
+    touchable->GetHistory()->GetTopTransform().TransformPoint(track->GetPosition());
+  G4ThreeVector localDirection = touchable->GetHistory()->GetTopTransform().TransformAxis(
+    track->GetMomentumDirection());
+  G4double distanceToOut =
+    track->GetVolume()->GetLogicalVolume()->GetSolid()->DistanceToOut(localPosition,
+                                                                      localDirection);
+  fForcedCaptureOperation->Sample(1. / analogInteractionLength,
+                                  std::max(distanceToOut, kCarTolerance));
+  fCaptureWeight = track->GetWeight();
+  return fForcedCaptureOperation;
+}
+
+void WLGDBiasForcedCapture::OperationApplied(
+  const G4BiasingProcessInterface* /*unused*/, G4BiasingAppliedCase /*unused*/,
+  G4VBiasingOperation* operationApplied, const G4VParticleChange* /*unused*/)
+{
+  if(operationApplied == fCloningOperation)
+  {
+    fCloningOperation->GetCloneTrack()->SetAuxiliaryTrackInformation(
+      fCloneModelID, new WLGDForcedCaptureClone());
+    Count(kClones);
+  }
+}
+
+void WLGDBiasForcedCapture::OperationApplied(
+  const G4BiasingProcessInterface* /*unused*/, G4BiasingAppliedCase /*unused*/,
+  G4VBiasingOperation* occurenceOperationApplied, G4double weightForOccurenceInteraction,
+  G4VBiasingOperation* /*unused*/, const G4VParticleChange* /*unused*/)
+{
+  if(occurenceOperationApplied == fForcedCaptureOperation)
+  {
+    Count(kCaptures);
+    Count(kCaptureWeight, fCaptureWeight * weightForOccurenceInteraction);
+  }
+}
+
+void WLGDBiasForcedCapture::Count(G4int which, G4double value)
+{
+  if(fCounts != nullptr)
+  {
+    fCounts->Add(which, value);
+  }
+}
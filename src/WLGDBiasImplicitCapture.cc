@@ -0,0 +1,137 @@
+// -- implicit capture (survival biasing): the capture is not simulated in the
+// -- chosen volumes, the weight is reduced instead by the analog probability of
+// -- not being captured along the step, and light particles are rouletted
+
+#include "WLGDBiasImplicitCapture.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4BOptnChangeCrossSection.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "WLGDBiasWeightRoulette.hh"
+#include "WLGDCountAccumulable.hh"
+
+WLGDBiasImplicitCapture::WLGDBiasImplicitCapture(const G4String& particleToBias,
+                                                 const std::vector<G4String>& volumes,
+                                                 G4double weightFloor,
+                                                 G4double survivalWeight,
+                                                 G4String captureProcess, G4String name)
+: G4VBiasingOperator(std::move(name))
+, fVolumes(volumes)
+, fWeightFloor(weightFloor)
+, fCaptureProcessName(std::move(captureProcess))
+{
+  fNoCaptureOperation = new G4BOptnChangeCrossSection("ImplicitCapture");
+  fRouletteOperation  = new WLGDBiasWeightRoulette("ImplicitCaptureRoulette");
+  fRouletteOperation->SetSurvivalWeight(survivalWeight);
+  fParticleToBias = G4ParticleTable::GetParticleTable()->FindParticle(particleToBias);
+
+  if(fParticleToBias == nullptr)
+  {
+    G4ExceptionDescription ed;
+    ed << "Particle `" << particleToBias << "' not found !" << G4endl;
+    G4Exception("WLGDBiasImplicitCapture(...)", "exWLGD.08", JustWarning, ed);
+  }
+}
+
+WLGDBiasImplicitCapture::~WLGDBiasImplicitCapture()
+{
+  delete fNoCaptureOperation;
+  delete fRouletteOperation;
+}
+
+void WLGDBiasImplicitCapture::StartRun()
+{
+  // -- the counters are registered by the run action, on master and workers alike:
+  fCounts = dynamic_cast<WLGDCountAccumulable*>(
+    G4AccumulableManager::Instance()->GetAccumulable("ImplicitCapture", false));
+
+  // -- several logical volumes may share a name, e.g. the moderator panels:
+  fImplicitVolumes.clear();
+  G4LogicalVolumeStore* volumeStore = G4LogicalVolumeStore::GetInstance();
+  for(const G4String& name : fVolumes)
+  {
+    std::size_t found = fImplicitVolumes.size();
+    for(const G4LogicalVolume* volume : *volumeStore)
+    {
+      if(volume->GetName() == name)
+        fImplicitVolumes.insert(volume);
+    }
+    if(fImplicitVolumes.size() == found)
+    {
+      G4ExceptionDescription ed;
+      ed << "Logical volume `" << name
+         << "' not found in this geometry, implicit capture ignored." << G4endl;
+      G4Exception("WLGDBiasImplicitCapture::StartRun()", "exWLGD.09", JustWarning, ed);
+    }
+  }
+
+  if(fParticleToBias == nullptr || fCaptureProcess != nullptr)
+  {
+    return;
+  }
+
+  const G4BiasingProcessSharedData* sharedData =
+    G4BiasingProcessInterface::GetSharedData(fParticleToBias->GetProcessManager());
+  if(sharedData != nullptr)
+  {
+    for(const auto* wrapperProcess : sharedData->GetPhysicsBiasingProcessInterfaces())
+    {
+      if(wrapperProcess->GetWrappedProcess()->GetProcessName() == fCaptureProcessName)
+      {
+        fCaptureProcess = wrapperProcess;
+      }
+    }
+  }
+
+  if(fCaptureProcess == nullptr)
+  {
+    G4ExceptionDescription ed;
+    ed << "Process `" << fCaptureProcessName << "' of `"
+       << fParticleToBias->GetParticleName()
+       << "' is not under biasing, capture stays analog." << G4endl;
+    G4Exception("WLGDBiasImplicitCapture::StartRun()", "exWLGD.10", JustWarning, ed);
+  }
+}
+
+G4VBiasingOperation* WLGDBiasImplicitCapture::ProposeOccurenceBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* callingProcess)
+{
+  if(callingProcess != fCaptureProcess || !IsImplicit(track))
+  {
+    return nullptr;
+  }
+
+  // -- a capture cross-section of zero makes the weight follow the analog
+  // -- probability of not being captured:
+  fNoCaptureOperation->SetBiasedCrossSection(0.);
+  fNoCaptureOperation->Sample();
+  return fNoCaptureOperation;
+}
+
+G4VBiasingOperation* WLGDBiasImplicitCapture::ProposeNonPhysicsBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* /*unused*/)
+{
+  if(fCaptureProcess == nullptr || track->GetWeight() >= fWeightFloor ||
+     !IsImplicit(track))
+  {
+    return nullptr;
+  }
+
+  return fRouletteOperation;
+}
+
+void WLGDBiasImplicitCapture::OperationApplied(
+  const G4BiasingProcessInterface* /*unused*/, G4BiasingAppliedCase /*unused*/,
+  G4VBiasingOperation* operationApplied, const G4VParticleChange* particleChangeProduced)
+{
+  if(operationApplied != fRouletteOperation || fCounts == nullptr)
+  {
+    return;
+  }
+  fCounts->Add((particleChangeProduced->GetTrackStatus() == fStopAndKill)
+                 ? kRouletteKilled
+                 : kRouletteSurvived);
+}
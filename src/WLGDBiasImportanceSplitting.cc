@@ -0,0 +1,84 @@
+// -- geometry based importance biasing, following GB03BOptrGeometryBasedBiasing of
+// -- examples/GB03newScorer but with the importance set per logical volume
+
+#include "WLGDBiasImportanceSplitting.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "WLGDBiasSplitOrKillOnBoundary.hh"
+#include "WLGDCountAccumulable.hh"
+
+const char* WLGDBiasImportanceSplitting::GetCountName(G4int which)
+{
+  static const char* names[kNumberOfSplitCounts] = { "split copies", "roulette killed",
+                                                      "roulette survived" };
+  return (which >= 0 && which < kNumberOfSplitCounts) ? names[which] : "unknown";
+}
+
+WLGDBiasImportanceSplitting::WLGDBiasImportanceSplitting(
+  const G4String& particleToBias, const std::map<G4String, G4double>& importances,
+  G4String name)
+: G4VBiasingOperator(std::move(name))
+, fImportances(importances)
+{
+  fSplitAndKillOperation = new WLGDBiasSplitOrKillOnBoundary(this);
+  fParticleToBias = G4ParticleTable::GetParticleTable()->FindParticle(particleToBias);
+
+  if(fParticleToBias == nullptr)
+  {
+    G4ExceptionDescription ed;
+    ed << "Particle `" << particleToBias << "' not found !" << G4endl;
+    G4Exception("WLGDBiasImportanceSplitting(...)", "exWLGD.03", JustWarning, ed);
+  }
+}
+
+WLGDBiasImportanceSplitting::~WLGDBiasImportanceSplitting()
+{
+  delete fSplitAndKillOperation;
+}
+
+void WLGDBiasImportanceSplitting::StartRun()
+{
+  // -- the counters are registered by the run action, on master and workers alike:
+  fCounts = dynamic_cast<WLGDCountAccumulable*>(
+    G4AccumulableManager::Instance()->GetAccumulable("ImportanceSplitting", false));
+
+  fImportanceOfVolume.clear();
+  G4LogicalVolumeStore* volumeStore = G4LogicalVolumeStore::GetInstance();
+  for(const auto& entry : fImportances)
+  {
+    G4LogicalVolume* volume = volumeStore->GetVolume(entry.first, false);
+    if(volume == nullptr)
+    {
+      G4ExceptionDescription ed;
+      ed << "Logical volume `" << entry.first
+         << "' not found in this geometry, importance ignored." << G4endl;
+      G4Exception("WLGDBiasImportanceSplitting::StartRun()", "exWLGD.04", JustWarning,
+                  ed);
+      continue;
+    }
+    fImportanceOfVolume[volume] = entry.second;
+  }
+}
+
+void WLGDBiasImportanceSplitting::Count(G4int which, G4double value)
+{
+  if(fCounts != nullptr)
+  {
+    fCounts->Add(which, value);
+  }
+}
+
+G4VBiasingOperation* WLGDBiasImportanceSplitting::ProposeNonPhysicsBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* /*unused*/)
+{
+  if(track->GetDefinition() != fParticleToBias)
+  {
+    return nullptr;
+  }
+
+  return fSplitAndKillOperation;
+}
@@ -10,13 +10,16 @@ WLGDBiasMultiParticleChangeCrossSection::WLGDBiasMultiParticleChangeCrossSection
 
 WLGDBiasMultiParticleChangeCrossSection::~WLGDBiasMultiParticleChangeCrossSection()
 {
+  // -- the particle and non-physics operators are shared, their owner is the
+  // -- detector construction
   for(auto& it : fBOptrForParticle)
   {
     delete it.second;
   }
 }
 
-void WLGDBiasMultiParticleChangeCrossSection::AddParticle(const G4String& particleName)
+void WLGDBiasMultiParticleChangeCrossSection::AddParticle(const G4String& particleName,
+                                                          G4bool          overridesOnly)
 {
   const G4ParticleDefinition* particle =
     G4ParticleTable::GetParticleTable()->FindParticle(particleName);
@@ -34,15 +37,64 @@ void WLGDBiasMultiParticleChangeCrossSection::AddParticle(const G4String& partic
   optr->SetNeutronFactor(fNeutronBias);
   optr->SetMuonFactor(fMuonBias);
   optr->SetNeutronYieldFactor(fNeutronYieldBias);
+  optr->SetFactorTable(fFactorTable);
+  optr->SetOverridesOnly(overridesOnly);
   G4cout << " >>> MultiBias: set neutron and muon factors to " << fNeutronBias << ", "
          << fMuonBias << ", " << fNeutronYieldBias << G4endl;
   fParticlesToBias.push_back(particle);
   fBOptrForParticle[particle] = optr;
 }
 
+void WLGDBiasMultiParticleChangeCrossSection::SetParticleOperator(
+  const G4String& particleName, G4VBiasingOperator* optr)
+{
+  const G4ParticleDefinition* particle =
+    G4ParticleTable::GetParticleTable()->FindParticle(particleName);
+
+  if(particle == nullptr)
+  {
+    G4ExceptionDescription ed;
+    ed << "Particle `" << particleName << "' not found !" << G4endl;
+    G4Exception("WLGDBiasMultiParticleChangeCrossSection::SetParticleOperator(...)",
+                "exWLGD.02", JustWarning, ed);
+    return;
+  }
+
+  fParticleOperators[particle] = optr;
+}
+
+G4bool WLGDBiasMultiParticleChangeCrossSection::HasParticle(
+  const G4String& particleName) const
+{
+  for(const auto* particle : fParticlesToBias)
+  {
+    if(particle->GetParticleName() == particleName)
+      return true;
+  }
+  return false;
+}
+
+void WLGDBiasMultiParticleChangeCrossSection::SetFactorTable(
+  const WLGDBiasChangeCrossSection::FactorTable* table)
+{
+  fFactorTable = table;
+  for(auto& it : fBOptrForParticle)
+  {
+    it.second->SetFactorTable(table);
+  }
+}
+
 G4VBiasingOperation*
 WLGDBiasMultiParticleChangeCrossSection::ProposeOccurenceBiasingOperation(
   const G4Track* track, const G4BiasingProcessInterface* callingProcess){
+  if(fCurrentParticleOperator != nullptr)
+  {
+    G4VBiasingOperation* operation =
+      fCurrentParticleOperator->GetProposedOccurenceBiasingOperation(track,
+                                                                     callingProcess);
+    if(operation != nullptr)
+      return operation;
+  }
   if(fCurrentOperator != nullptr)
   {
     return fCurrentOperator->GetProposedOccurenceBiasingOperation(track, callingProcess);
@@ -51,6 +103,39 @@ WLGDBiasMultiParticleChangeCrossSection::ProposeOccurenceBiasingOperation(
   return nullptr;
 }
 
+G4VBiasingOperation*
+WLGDBiasMultiParticleChangeCrossSection::ProposeFinalStateBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* callingProcess){
+  if(fCurrentParticleOperator != nullptr)
+  {
+    return fCurrentParticleOperator->GetProposedFinalStateBiasingOperation(track,
+                                                                           callingProcess);
+  }
+
+  return nullptr;
+}
+
+G4VBiasingOperation*
+WLGDBiasMultiParticleChangeCrossSection::ProposeNonPhysicsBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* callingProcess){
+  // -- the particle operator comes first, the shared one acts when it does not:
+  fCurrentNonPhysicsOperator = nullptr;
+  for(G4VBiasingOperator* optr : { fCurrentParticleOperator, fNonPhysicsOperator })
+  {
+    if(optr == nullptr)
+      continue;
+    G4VBiasingOperation* operation =
+      optr->GetProposedNonPhysicsBiasingOperation(track, callingProcess);
+    if(operation != nullptr)
+    {
+      fCurrentNonPhysicsOperator = optr;
+      return operation;
+    }
+  }
+
+  return nullptr;
+}
+
 void WLGDBiasMultiParticleChangeCrossSection::StartTracking(const G4Track* track){
   // -- fetch the underneath biasing operator, if any, for the current particle type:
   const G4ParticleDefinition* definition = track->GetParticleDefinition();
@@ -60,6 +145,12 @@ void WLGDBiasMultiParticleChangeCrossSection::StartTracking(const G4Track* track
   {
     fCurrentOperator = (*it).second;
   }
+  auto particleIt          = fParticleOperators.find(definition);
+  fCurrentParticleOperator = nullptr;
+  if(particleIt != fParticleOperators.end())
+  {
+    fCurrentParticleOperator = (*particleIt).second;
+  }
 }
 
 void WLGDBiasMultiParticleChangeCrossSection::OperationApplied(
@@ -67,11 +158,29 @@ void WLGDBiasMultiParticleChangeCrossSection::OperationApplied(
   G4VBiasingOperation* occurenceOperationApplied, G4double weightForOccurenceInteraction,
   G4VBiasingOperation*     finalStateOperationApplied,
   const G4VParticleChange* particleChangeProduced){
-  // -- inform the underneath biasing operator that a biased interaction occured:
-  if(fCurrentOperator != nullptr)
+  // -- inform the underneath biasing operators that a biased interaction occured,
+  // -- each of them checks whether the operation is its own:
+  for(G4VBiasingOperator* optr : { fCurrentParticleOperator,
+                                   static_cast<G4VBiasingOperator*>(fCurrentOperator) })
+  {
+    if(optr != nullptr)
+    {
+      optr->ReportOperationApplied(callingProcess, biasingCase, occurenceOperationApplied,
+                                   weightForOccurenceInteraction,
+                                   finalStateOperationApplied, particleChangeProduced);
+    }
+  }
+}
+
+void WLGDBiasMultiParticleChangeCrossSection::OperationApplied(
+  const G4BiasingProcessInterface* callingProcess, G4BiasingAppliedCase biasingCase,
+  G4VBiasingOperation* operationApplied, const G4VParticleChange* particleChangeProduced){
+  // -- inform the operator which proposed the operation that it was applied:
+  G4VBiasingOperator* optr =
+    (biasingCase == BAC_NonPhysics) ? fCurrentNonPhysicsOperator : fCurrentParticleOperator;
+  if(optr != nullptr)
   {
-    fCurrentOperator->ReportOperationApplied(
-      callingProcess, biasingCase, occurenceOperationApplied,
-      weightForOccurenceInteraction, finalStateOperationApplied, particleChangeProduced);
+    optr->ReportOperationApplied(callingProcess, biasingCase, operationApplied,
+                                 particleChangeProduced);
   }
 }
@@ -0,0 +1,95 @@
+// -- geometry importance splitting and Russian roulette, following the
+// -- GB03BOptnSplitOrKillOnBoundary operation of examples/GB03newScorer
+
+#include "WLGDBiasSplitOrKillOnBoundary.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "Randomize.hh"
+#include "WLGDBiasImportanceSplitting.hh"
+
+WLGDBiasSplitOrKillOnBoundary::WLGDBiasSplitOrKillOnBoundary(
+  WLGDBiasImportanceSplitting* importances, G4String name)
+: G4VBiasingOperation(std::move(name))
+, fImportances(importances)
+{}
+
+G4double WLGDBiasSplitOrKillOnBoundary::DistanceToApplyOperation(
+  const G4Track*, G4double, G4ForceCondition* condition)
+{
+  // -- return "infinite" distance for interaction, but asks for GenerateBiasingFinalState
+  // -- being called anyway at the end of the step, so that the boundary can be checked:
+  *condition = Forced;
+  return DBL_MAX;
+}
+
+G4VParticleChange* WLGDBiasSplitOrKillOnBoundary::GenerateBiasingFinalState(
+  const G4Track* track, const G4Step* step)
+{
+  fParticleChangeForNothing.Initialize(*track);
+
+  // -- act only when the step is limited by a volume boundary, and not on the
+  // -- first step of a track, which may start on a boundary it was cloned at:
+  if(step->GetPostStepPoint()->GetStepStatus() != fGeomBoundary ||
+     track->GetCurrentStepNumber() == 1)
+  {
+    return &fParticleChangeForNothing;
+  }
+
+  // -- a track leaving the world has no next volume:
+  const G4VPhysicalVolume* postVolume = step->GetPostStepPoint()->GetPhysicalVolume();
+  if(postVolume == nullptr)
+  {
+    return &fParticleChangeForNothing;
+  }
+
+  const G4LogicalVolume* preVolume =
+    step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume();
+  G4double ratio = fImportances->GetImportance(postVolume->GetLogicalVolume()) /
+                   fImportances->GetImportance(preVolume);
+  if(ratio == 1.)
+  {
+    return &fParticleChangeForNothing;
+  }
+
+  G4double weight = track->GetWeight();
+  fParticleChange.Initialize(*track);
+
+  if(ratio > 1.)
+  {
+    // -- split: produce floor(ratio) or floor(ratio)+1 copies, so that on average
+    // -- ratio copies of weight w/ratio cross the boundary:
+    auto nCopies = static_cast<G4int>(ratio);
+    if(G4UniformRand() < ratio - nCopies)
+    {
+      ++nCopies;
+    }
+    G4double splitWeight = weight / ratio;
+    fParticleChange.ProposeParentWeight(splitWeight);
+    fParticleChange.SetSecondaryWeightByProcess(true);
+    fParticleChange.SetNumberOfSecondaries(nCopies - 1);
+    for(G4int i = 1; i < nCopies; ++i)
+    {
+      auto* clone = new G4Track(*track);
+      clone->SetWeight(splitWeight);
+      fParticleChange.AddSecondary(clone);
+    }
+    fImportances->Count(WLGDBiasImportanceSplitting::kSplitCopies, nCopies - 1);
+  }
+  else
+  {
+    // -- Russian roulette: survive with probability ratio, at weight w/ratio:
+    if(G4UniformRand() < ratio)
+    {
+      fParticleChange.ProposeParentWeight(weight / ratio);
+      fImportances->Count(WLGDBiasImportanceSplitting::kRouletteSurvived);
+    }
+    else
+    {
+      fParticleChange.ProposeTrackStatus(fStopAndKill);
+      fImportances->Count(WLGDBiasImportanceSplitting::kRouletteKilled);
+    }
+  }
+
+  return &fParticleChange;
+}
@@ -0,0 +1,32 @@
+// -- forced interaction along the remaining chord, as done by the
+// -- G4BOptnForceCommonTruncatedExp operation but for a single process
+
+#include "WLGDBiasTruncatedExpCapture.hh"
+
+#include "G4ILawTruncatedExp.hh"
+
+WLGDBiasTruncatedExpCapture::WLGDBiasTruncatedExpCapture(G4String name)
+: G4VBiasingOperation(name)
+{
+  fTruncatedExpLaw = new G4ILawTruncatedExp("LawForOperation" + name);
+}
+
+WLGDBiasTruncatedExpCapture::~WLGDBiasTruncatedExpCapture()
+{
+  delete fTruncatedExpLaw;
+}
+
+const G4VBiasingInteractionLaw*
+WLGDBiasTruncatedExpCapture::ProvideOccurenceBiasingInteractionLaw(
+  const G4BiasingProcessInterface*, G4ForceCondition&)
+{
+  return fTruncatedExpLaw;
+}
+
+void WLGDBiasTruncatedExpCapture::Sample(G4double crossSection,
+                                         G4double maximumDistance)
+{
+  fTruncatedExpLaw->SetForceCrossSection(crossSection);
+  fTruncatedExpLaw->SetMaximumDistance(maximumDistance);
+  fTruncatedExpLaw->SampleInteractionLength();
+}
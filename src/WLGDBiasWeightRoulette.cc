@@ -0,0 +1,33 @@
+// -- Russian roulette of a track whose weight fell below a floor
+
+#include "WLGDBiasWeightRoulette.hh"
+
+#include "Randomize.hh"
+
+WLGDBiasWeightRoulette::WLGDBiasWeightRoulette(G4String name)
+: G4VBiasingOperation(std::move(name))
+{}
+
+G4double WLGDBiasWeightRoulette::DistanceToApplyOperation(const G4Track*, G4double,
+                                                          G4ForceCondition* condition)
+{
+  *condition = NotForced;
+  return 0.;
+}
+
+G4VParticleChange* WLGDBiasWeightRoulette::GenerateBiasingFinalState(
+  const G4Track* track, const G4Step* /*unused*/)
+{
+  fParticleChange.Initialize(*track);
+
+  // -- survive with probability weight/survival weight, keeping the expected weight:
+  if(G4UniformRand() * fSurvivalWeight < track->GetWeight())
+  {
+    fParticleChange.ProposeParentWeight(fSurvivalWeight);
+  }
+  else
+  {
+    fParticleChange.ProposeTrackStatus(fStopAndKill);
+  }
+  return &fParticleChange;
+}
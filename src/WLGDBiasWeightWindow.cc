@@ -0,0 +1,174 @@
+// -- weight-window biasing: keeps the weight of the biased particle inside a band
+// -- set per logical volume or region and energy group
+
+#include "WLGDBiasWeightWindow.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4Region.hh"
+#include "G4SystemOfUnits.hh"
+#include "WLGDBiasApplyWeightWindow.hh"
+#include "WLGDCountAccumulable.hh"
+
+#include <fstream>
+#include <sstream>
+
+const char* WLGDBiasWeightWindow::GetCountName(G4int which)
+{
+  static const char* names[kNumberOfWindowCounts] = { "entered", "split copies",
+                                                       "roulette killed",
+                                                       "roulette survived" };
+  return (which >= 0 && which < kNumberOfWindowCounts) ? names[which] : "unknown";
+}
+
+std::vector<WLGDBiasWeightWindow::Window> WLGDBiasWeightWindow::ReadWindows(
+  const G4String& fileName)
+{
+  std::vector<Window> windows;
+  std::ifstream       input(fileName);
+  if(!input)
+  {
+    G4ExceptionDescription ed;
+    ed << "Cannot open weight-window file `" << fileName << "'." << G4endl;
+    G4Exception("WLGDBiasWeightWindow::ReadWindows(...)", "exWLGD.05", JustWarning, ed);
+    return windows;
+  }
+
+  std::string line;
+  G4int       lineNumber = 0;
+  while(std::getline(input, line))
+  {
+    ++lineNumber;
+    line = line.substr(0, line.find('#'));
+    std::istringstream fields(line);
+    Window             window;
+    if(!(fields >> window.volume))
+    {
+      continue;  // blank or comment line
+    }
+    if(!(fields >> window.minEkin >> window.maxEkin >> window.lowerWeight >>
+         window.upperWeight) ||
+       window.minEkin >= window.maxEkin || window.lowerWeight <= 0. ||
+       window.lowerWeight >= window.upperWeight)
+    {
+      G4ExceptionDescription ed;
+      ed << "Malformed weight window at " << fileName << ":" << lineNumber
+         << ", line ignored." << G4endl;
+      G4Exception("WLGDBiasWeightWindow::ReadWindows(...)", "exWLGD.05", JustWarning,
+                  ed);
+      continue;
+    }
+    if(!(fields >> window.survivalWeight))
+    {
+      window.survivalWeight = 0.5 * (window.lowerWeight + window.upperWeight);
+    }
+    // -- a survivor below the window would lose weight, one above it be split again:
+    else if(window.survivalWeight < window.lowerWeight ||
+            window.survivalWeight > window.upperWeight)
+    {
+      G4ExceptionDescription ed;
+      ed << "Survival weight outside the weight window at " << fileName << ":"
+         << lineNumber << ", line ignored." << G4endl;
+      G4Exception("WLGDBiasWeightWindow::ReadWindows(...)", "exWLGD.05", JustWarning,
+                  ed);
+      continue;
+    }
+    window.minEkin *= MeV;
+    window.maxEkin *= MeV;
+    windows.push_back(window);
+  }
+  return windows;
+}
+
+WLGDBiasWeightWindow::WLGDBiasWeightWindow(const G4String&            particleToBias,
+                                           const std::vector<Window>& windows,
+                                           G4String                   name)
+: G4VBiasingOperator(std::move(name))
+, fWindows(windows)
+{
+  fWeightWindowOperation = new WLGDBiasApplyWeightWindow(this);
+  fParticleToBias = G4ParticleTable::GetParticleTable()->FindParticle(particleToBias);
+
+  if(fParticleToBias == nullptr)
+  {
+    G4ExceptionDescription ed;
+    ed << "Particle `" << particleToBias << "' not found !" << G4endl;
+    G4Exception("WLGDBiasWeightWindow(...)", "exWLGD.03", JustWarning, ed);
+  }
+}
+
+WLGDBiasWeightWindow::~WLGDBiasWeightWindow() { delete fWeightWindowOperation; }
+
+void WLGDBiasWeightWindow::StartRun()
+{
+  // -- the counters are registered by the run action, on master and workers alike:
+  fCounts = dynamic_cast<WLGDCountAccumulable*>(
+    G4AccumulableManager::Instance()->GetAccumulable("WeightWindows", false));
+
+  // -- windows naming a logical volume take precedence over those naming its region:
+  fWindowsOfVolume.clear();
+  for(G4LogicalVolume* volume : *G4LogicalVolumeStore::GetInstance())
+  {
+    std::vector<G4int> byVolume;
+    std::vector<G4int> byRegion;
+    for(std::size_t i = 0; i < fWindows.size(); ++i)
+    {
+      if(fWindows[i].volume == volume->GetName())
+      {
+        byVolume.push_back(i);
+      }
+      else if(volume->GetRegion() != nullptr &&
+              fWindows[i].volume == volume->GetRegion()->GetName())
+      {
+        byRegion.push_back(i);
+      }
+    }
+    if(!byVolume.empty())
+    {
+      fWindowsOfVolume[volume] = byVolume;
+    }
+    else if(!byRegion.empty())
+    {
+      fWindowsOfVolume[volume] = byRegion;
+    }
+  }
+}
+
+G4int WLGDBiasWeightWindow::FindWindow(const G4LogicalVolume* volume, G4double ekin) const
+{
+  auto it = fWindowsOfVolume.find(volume);
+  if(it == fWindowsOfVolume.end())
+  {
+    return -1;
+  }
+  for(G4int window : it->second)
+  {
+    if(ekin >= fWindows[window].minEkin && ekin < fWindows[window].maxEkin)
+    {
+      return window;
+    }
+  }
+  return -1;
+}
+
+void WLGDBiasWeightWindow::Count(G4int window, G4int which, G4double value)
+{
+  if(fCounts != nullptr)
+  {
+    fCounts->Add(window * kNumberOfWindowCounts + which, value);
+  }
+}
+
+G4VBiasingOperation* WLGDBiasWeightWindow::ProposeNonPhysicsBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* /*unused*/)
+{
+  if(track->GetDefinition() != fParticleToBias)
+  {
+    return nullptr;
+  }
+
+  return fWeightWindowOperation;
+}
@@ -0,0 +1,244 @@
+#include "WLGDCheckpoint.hh"
+#include "WLGDPrimaryGeneratorAction.hh"
+#include "WLGDRunAction.hh"
+
+#include "G4RunManager.hh"
+#include "G4Threading.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+std::atomic<G4int> WLGDCheckpoint::fShard{ -1 };
+
+namespace
+{
+  // -- generator states by thread ID: saved at the end of each checkpointed run,
+  // -- and read from a checkpoint until the thread picks its state up
+  std::mutex                   stateMutex;
+  std::map<G4int, std::string> savedStates;
+  std::map<G4int, std::string> resumedStates;
+}  // namespace
+
+WLGDCheckpoint::WLGDCheckpoint(const G4String& outputFileName)
+: fOutputFileName(outputFileName)
+{
+  fFileName = outputFileName;
+  if(fFileName.size() > 5 && fFileName.substr(fFileName.size() - 5) == ".root")
+    fFileName = fFileName.substr(0, fFileName.size() - 5);
+  fFileName += ".checkpoint";
+  DefineCommands();
+}
+
+WLGDCheckpoint::~WLGDCheckpoint() { delete fMessenger; }
+
+void WLGDCheckpoint::Resume(const G4String& fileName)
+{
+  std::ifstream in(fileName);
+  if(!in.good())
+  {
+    G4ExceptionDescription msg;
+    msg << "Checkpoint `" << fileName << "' can not be read.";
+    G4Exception("WLGDCheckpoint::Resume()", "MyCode0017", FatalException, msg);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(stateMutex);
+  resumedStates.clear();
+  fCounters.clear();
+  fEngineState.clear();
+
+  std::string line;
+  while(std::getline(in, line))
+  {
+    std::istringstream fields(line);
+    std::string        key;
+    fields >> key;
+    if(key.empty() || key[0] == '#')
+      continue;
+    if(key == "output")
+    {
+      std::string output;
+      fields >> std::quoted(output);
+      if(output != fOutputFileName)
+        G4cout << "Checkpoint of output " << output << " resumed with output "
+               << fOutputFileName << G4endl;
+    }
+    else if(key == "events")
+      fields >> fEvents;
+    else if(key == "done")
+      fields >> fDone;
+    else if(key == "shard")
+      fields >> fNextShard;
+    else if(key == "counter")
+    {
+      std::string name;
+      G4double    value = 0.;
+      fields >> name >> value;
+      fCounters[name] = value;
+    }
+    else if(key == "thread")
+    {
+      G4int       thread = 0;
+      std::string state;
+      fields >> thread;
+      std::getline(fields >> std::ws, state);
+      resumedStates[thread] = state;
+    }
+    else if(key == "engine")
+    {
+      // -- the engine writes its own format, up to the end of the file
+      std::ostringstream engine;
+      engine << in.rdbuf();
+      fEngineState = engine.str();
+      break;
+    }
+  }
+
+  fResumed = true;
+  G4cout << "Resuming checkpoint " << fileName << ": " << fDone << " of " << fEvents
+         << " events done in " << fNextShard << " shards" << G4endl;
+}
+
+void WLGDCheckpoint::BeamOn(G4int events)
+{
+  auto* runManager = G4RunManager::GetRunManager();
+  // -- on the master of a MT run this is the master run action, which merges
+  // -- the counters of all workers
+  const auto* runAction = static_cast<const WLGDRunAction*>(runManager->GetUserRunAction());
+
+  if(fResumed)
+  {
+    if(events != fEvents)
+      G4cout << "Checkpoint of " << fEvents << " events resumed for " << events
+             << " events" << G4endl;
+    // -- the event seeds of MT runs are drawn from the engine of the master
+    if(!fEngineState.empty())
+    {
+      std::istringstream engine(fEngineState);
+      G4Random::getTheEngine()->get(engine);
+    }
+  }
+  else
+  {
+    fDone      = 0;
+    fNextShard = 0;
+    fCounters.clear();
+  }
+  fEvents  = events;
+  fResumed = false;
+
+  while(fDone < fEvents)
+  {
+    G4int runEvents = std::min(fInterval, fEvents - fDone);
+    fShard          = fNextShard;
+    runManager->BeamOn(runEvents);
+    fShard = -1;
+
+    fDone += runEvents;
+    ++fNextShard;
+    for(const auto& counter : runAction->GetRunCounters())
+      fCounters[counter.first] += counter.second;
+    Write();
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if(!resumedStates.empty())
+    {
+      G4ExceptionDescription msg;
+      msg << resumedStates.size()
+          << " generator states of the checkpoint have no thread to resume them.";
+      G4Exception("WLGDCheckpoint::BeamOn()", "MyCode0017", JustWarning, msg);
+      resumedStates.clear();
+    }
+  }
+
+  G4cout << "Checkpointed run: " << fDone << " events in " << fNextShard
+         << " shards of " << fOutputFileName << ", checkpoint " << fFileName << G4endl;
+  for(const auto& counter : fCounters)
+    G4cout << "  " << counter.first << ": " << counter.second << G4endl;
+}
+
+void WLGDCheckpoint::RestoreThreadState(WLGDPrimaryGeneratorAction& generator)
+{
+  std::lock_guard<std::mutex> lock(stateMutex);
+  auto it = resumedStates.find(G4Threading::G4GetThreadId());
+  if(it == resumedStates.end())
+    return;
+  std::istringstream state(it->second);
+  generator.RestoreState(state);
+  resumedStates.erase(it);
+}
+
+void WLGDCheckpoint::SaveThreadState(WLGDPrimaryGeneratorAction& generator)
+{
+  if(fShard < 0)
+    return;
+  std::ostringstream state;
+  generator.SaveState(state);
+  std::lock_guard<std::mutex> lock(stateMutex);
+  savedStates[G4Threading::G4GetThreadId()] = state.str();
+}
+
+void WLGDCheckpoint::Write() const
+{
+  // -- written aside and renamed, so a job stopped meanwhile keeps the last one
+  G4String      temporary = fFileName + ".tmp";
+  std::ofstream out(temporary, std::ios::trunc);
+  out << "# checkpoint of /WLGD/checkpoint/beamOn, continue with --resume "
+      << fFileName << "\n";
+  out << "output " << std::quoted(std::string(fOutputFileName)) << "\n";
+  out << "events " << fEvents << "\n";
+  out << "done " << fDone << "\n";
+  out << "shard " << fNextShard << "\n";
+  out << std::setprecision(17);
+  for(const auto& counter : fCounters)
+    out << "counter " << counter.first << " " << counter.second << "\n";
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    for(const auto& state : savedStates)
+      out << "thread " << state.first << " " << state.second << "\n";
+  }
+  out << "engine\n";
+  G4Random::getTheEngine()->put(out);
+  out.close();
+
+  if(!out || std::rename(temporary.c_str(), fFileName.c_str()) != 0)
+  {
+    G4ExceptionDescription msg;
+    msg << "Checkpoint `" << fFileName << "' could not be written.";
+    G4Exception("WLGDCheckpoint::Write()", "MyCode0017", JustWarning, msg);
+  }
+}
+
+void WLGDCheckpoint::DefineCommands()
+{
+  fMessenger = new G4GenericMessenger(this, "/WLGD/checkpoint/",
+                                      "Commands for checkpointed production runs");
+
+  fMessenger->DeclareProperty("setInterval", fInterval)
+    .SetGuidance("Set the number of events between two checkpoints.")
+    .SetGuidance("Each interval is a run writing its own output shard.")
+    .SetParameterName("events", false)
+    .SetRange("events > 0")
+    .SetDefaultValue("10000")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("setFile", fFileName)
+    .SetGuidance("Set the checkpoint file, by default <output>.checkpoint.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("beamOn", &WLGDCheckpoint::BeamOn)
+    .SetGuidance("Run the events in runs of the checkpoint interval, writing the")
+    .SetGuidance("checkpoint after each. With --resume, the finished runs of the")
+    .SetGuidance("checkpoint are skipped.")
+    .SetParameterName("events", false)
+    .SetRange("events > 0")
+    .SetStates(G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
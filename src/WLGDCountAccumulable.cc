@@ -0,0 +1,16 @@
+#include "WLGDCountAccumulable.hh"
+
+WLGDCountAccumulable::WLGDCountAccumulable(const G4String& name)
+: G4VAccumulable(name)
+{}
+
+void WLGDCountAccumulable::Merge(const G4VAccumulable& other)
+{
+  const auto& values = static_cast<const WLGDCountAccumulable&>(other).fValues;
+  if(values.size() > fValues.size())
+    fValues.resize(values.size(), 0.);
+  for(std::size_t i = 0; i < values.size(); ++i)
+    fValues[i] += values[i];
+}
+
+void WLGDCountAccumulable::Reset() { fValues.assign(fValues.size(), 0.); }
@@ -1,6 +1,8 @@
 #include "WLGDDetectorConstruction.hh"
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
 #include <set>
 
 #include "G4RunManager.hh"
@@ -16,8 +18,12 @@
 #include "G4PVPlacement.hh"
 #include "G4PVReplica.hh"
 #include "G4PhysicalVolumeStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
 #include "G4SolidStore.hh"
 #include "G4Tubs.hh"
+#include "G4UserLimits.hh"
 
 #include "G4Colour.hh"
 #include "G4VisAttributes.hh"
@@ -25,10 +31,23 @@
 #include "G4SDManager.hh"
 #include "WLGDCrystalSD.hh"
 
+#include "WLGDBiasForcedCapture.hh"
+#include "WLGDBiasImplicitCapture.hh"
+#include "WLGDBiasImportanceSplitting.hh"
 #include "WLGDBiasMultiParticleChangeCrossSection.hh"
+#include "WLGDBiasWeightWindow.hh"
+#include "WLGDRegionInformation.hh"
 
 #include "G4PhysicalConstants.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+
+namespace
+{
+  // -- Owner of the operators shared by the multi-particle operators of a thread
+  // -- (splitting, forced and implicit capture); those keep plain pointers only
+  thread_local std::vector<std::unique_ptr<G4VBiasingOperator>> sharedOperators;
+}  // namespace
 
 WLGDDetectorConstruction::WLGDDetectorConstruction()
 {
@@ -40,6 +59,9 @@ WLGDDetectorConstruction::~WLGDDetectorConstruction()
 {
   delete fDetectorMessenger;
   delete fBiasMessenger;
+  delete fMaterialMessenger;
+  for(auto& entry : fRegionSettings)
+    delete entry.second.messenger;
 }
 
 auto WLGDDetectorConstruction::Construct() -> G4VPhysicalVolume*
@@ -51,19 +73,111 @@ auto WLGDDetectorConstruction::Construct() -> G4VPhysicalVolume*
   G4LogicalVolumeStore::GetInstance()->Clean();
   G4SolidStore::GetInstance()->Clean();
 
+  G4VPhysicalVolume* world = nullptr;
   if(fGeometryName == "baseline" || fGeometryName == "baseline_smaller" || fGeometryName == "baseline_large_reentrance_tube" || fGeometryName == "baseline_large_reentrance_tube_4m_cryo")
-    return SetupBaseline();
+    world = SetupBaseline();
 
   else if(fGeometryName == "hallA" || fGeometryName == "hallA_wo_ge" || fGeometryName == "hallA_only_WLSR")
-    return SetupHallA();
+    world = SetupHallA();
 
   else
-    return SetupAlternative();
+    world = SetupAlternative();
+
+  ConstructRegions();
+
+  return world;
 
 }//Construct()
 
 
 
+// -- group the volumes far from the detector into regions so that production cuts
+// -- and user limits can be relaxed there without touching the Ge region.
+// -- Daughters inherit the region of their mother unless they are a root of their own.
+// -- Every region, including the world, carries a WLGDRegionInformation with its role
+// -- and the neutron cuts applied by the stepping action.
+void WLGDDetectorConstruction::ConstructRegions()
+{
+  G4LogicalVolumeStore* volumeStore = G4LogicalVolumeStore::GetInstance();
+  G4RegionStore*        regionStore = G4RegionStore::GetInstance();
+
+  const std::map<G4String, std::vector<G4String>> regionVolumes = {
+    { "Rock", { "Cavern_log" } },
+    { "Hall", { "Hall_log" } },
+    { "Water", { "Water_log" } },
+    { "Cryostat", { "Cout_log", "Lid_log", "Bot_log", "Pu_log" } },
+    { "Inner", { "Lar_log" } }
+  };
+  const std::map<G4String, WLGDRegionInformation::Role> regionRoles = {
+    { "World", WLGDRegionInformation::kWorld },
+    { "Rock", WLGDRegionInformation::kRock },
+    { "Hall", WLGDRegionInformation::kHall },
+    { "Water", WLGDRegionInformation::kWater },
+    { "Cryostat", WLGDRegionInformation::kCryostat },
+    { "Inner", WLGDRegionInformation::kInner }
+  };
+
+  for(const auto& entry : regionVolumes)
+  {
+    G4Region* region = regionStore->FindOrCreateRegion(entry.first);
+    for(const auto& volumeName : entry.second)
+    {
+      G4LogicalVolume* volume = volumeStore->GetVolume(volumeName, false);
+      if(volume != nullptr)
+        region->AddRootLogicalVolume(volume);
+    }
+  }
+
+  // the steel tank is part of the water shield, except for the alternative geometry
+  // where it is the cryostat itself
+  G4LogicalVolume* tank = volumeStore->GetVolume("Tank_log", false);
+  if(tank != nullptr)
+    regionStore->GetRegion(fGeometryName == "alternative" ? "Cryostat" : "Water")
+      ->AddRootLogicalVolume(tank);
+
+  for(const auto& entry : fRegionSettings)
+  {
+    const RegionSettings& settings = entry.second;
+    G4Region*             region   = (entry.first == "World")
+                                       ? regionStore->GetRegion("DefaultRegionForTheWorld")
+                                       : regionStore->GetRegion(entry.first);
+
+    auto* information = dynamic_cast<WLGDRegionInformation*>(region->GetUserInformation());
+    if(information == nullptr)
+    {
+      information = new WLGDRegionInformation(regionRoles.at(entry.first));
+      region->SetUserInformation(information);
+    }
+    information->SetNeutronTimeCut(settings.neutronTimeCut);
+    information->SetNeutronEkinCut(settings.neutronEkinCut);
+
+    if(settings.productionCut >= 0.)
+    {
+      G4ProductionCuts* cuts = region->GetProductionCuts();
+      if(cuts == nullptr)
+      {
+        cuts = new G4ProductionCuts();
+        region->SetProductionCuts(cuts);
+      }
+      cuts->SetProductionCut(settings.productionCut);
+      G4cout << " >>> Detector: region " << entry.first << " production cut "
+             << G4BestUnit(settings.productionCut, "Length") << G4endl;
+    }
+
+    if(settings.maxTime >= 0. || settings.minEkin >= 0. || settings.minRange >= 0.)
+    {
+      delete region->GetUserLimits();
+      region->SetUserLimits(new G4UserLimits(
+        DBL_MAX, DBL_MAX, (settings.maxTime >= 0.) ? settings.maxTime : DBL_MAX,
+        (settings.minEkin >= 0.) ? settings.minEkin : 0.,
+        (settings.minRange >= 0.) ? settings.minRange : 0.));
+      G4cout << " >>> Detector: region " << entry.first << " user limits set" << G4endl;
+    }
+  }
+}
+
+
+
 void WLGDDetectorConstruction::DefineMaterials()
 {
   
@@ -380,22 +494,35 @@ void WLGDDetectorConstruction::ConstructSDandField()
     
     // -- Attach neutron XS biasing to Germanium -> enhance nCapture
     auto* biasnXS = new WLGDBiasMultiParticleChangeCrossSection();
-    biasnXS->SetNeutronFactor(fNeutronBias);
-    biasnXS->SetMuonFactor(fMuonBias);
-    G4cout << " >>> Detector: set neutron bias to " << fNeutronBias << G4endl;
+    biasnXS->SetNeutronFactor(fBiasFactors.neutronBias);
+    biasnXS->SetMuonFactor(fBiasFactors.muonBias);
+    biasnXS->SetFactorTable(&fBiasFactors);
+    G4cout << " >>> Detector: set neutron bias to " << fBiasFactors.neutronBias << G4endl;
     biasnXS->AddParticle("neutron");
+    // -- or force the neutron capture along the chord through each crystal, in
+    // -- place of the nCapture cross-section bias there; the forced capture is
+    // -- consulted first, the other neutron processes keep their factors
+    if(fForcedCapture != 0)
+      {
+	auto* forcedCapture = new WLGDBiasForcedCapture("neutron");
+	sharedOperators.emplace_back(forcedCapture);
+	biasnXS->SetParticleOperator("neutron", forcedCapture);
+	G4cout << " >>> Detector: forced neutron capture in Ge_log, replacing its nCapture"
+	       << " factor there" << G4endl;
+      }
     G4LogicalVolume* logicGe = volumeStore->GetVolume("Ge_log");
     biasnXS->AttachTo(logicGe);
 
     // -- Attach muon XS biasing to all required volumes consistently
     auto* biasmuXS = new WLGDBiasMultiParticleChangeCrossSection();
-    biasmuXS->SetNeutronFactor(fNeutronBias);
-    biasmuXS->SetMuonFactor(fMuonBias);
-    biasmuXS->SetNeutronYieldFactor(fNeutronYieldBias);
-    G4cout << " >>> Detector: set muon bias to " << fMuonBias << G4endl;
+    biasmuXS->SetNeutronFactor(fBiasFactors.neutronBias);
+    biasmuXS->SetMuonFactor(fBiasFactors.muonBias);
+    biasmuXS->SetNeutronYieldFactor(fBiasFactors.neutronYieldBias);
+    biasmuXS->SetFactorTable(&fBiasFactors);
+    G4cout << " >>> Detector: set muon bias to " << fBiasFactors.muonBias << G4endl;
     biasmuXS->AddParticle("mu-");
 
-    if(fNeutronYieldBias != 1)
+    if(fBiasFactors.neutronYieldBias != 1)
       {
 	biasmuXS->AddParticle("neutron");
 	biasmuXS->AddParticle("pi+");
@@ -452,6 +579,99 @@ void WLGDDetectorConstruction::ConstructSDandField()
 	G4LogicalVolume* logicMembrane = volumeStore->GetVolume("Membrane_log");
 	biasmuXS->AttachTo(logicMembrane);
       }
+
+    // -- Particles named by /WLGD/bias/setFactor are biased by their overrides
+    // -- alone wherever they are not biased already
+    std::vector<G4String> overrideParticles;
+    for(const auto& entry : fBiasFactors.overrides)
+      {
+	if(entry.particle != "*" && !biasmuXS->HasParticle(entry.particle))
+	  biasmuXS->AddParticle(entry.particle, true);
+	if(entry.particle != "*" && !biasnXS->HasParticle(entry.particle))
+	  biasnXS->AddParticle(entry.particle, true);
+	if(entry.particle != "*" &&
+	   std::find(overrideParticles.begin(), overrideParticles.end(), entry.particle) ==
+	     overrideParticles.end())
+	  overrideParticles.push_back(entry.particle);
+      }
+
+    // -- The neutron exponential transform acts through the XS operators, so
+    // -- neutrons need one in every volume
+    if(fBiasFactors.transformStrength != 0.)
+      {
+	if(!biasmuXS->HasParticle("neutron"))
+	  biasmuXS->AddParticle("neutron", true);
+	if(!biasnXS->HasParticle("neutron"))
+	  biasnXS->AddParticle("neutron", true);
+	if(std::find(overrideParticles.begin(), overrideParticles.end(), "neutron") ==
+	   overrideParticles.end())
+	  overrideParticles.push_back("neutron");
+	G4cout << " >>> Detector: neutron exponential transform, strength "
+	       << fBiasFactors.transformStrength << " toward "
+	       << G4BestUnit(fBiasFactors.transformTarget, "Length") << G4endl;
+      }
+
+    // -- Neutron splitting and roulette, by weight windows or else by importance:
+    // -- the operator is shared by the XS operators and by the operator attached
+    // -- to every other volume below, so that all boundaries crossed by a
+    // -- neutron are seen
+    G4VBiasingOperator* splitting = nullptr;
+    if(!fWeightWindows.empty())
+      {
+	if(!fImportances.empty())
+	  G4cout << " >>> Detector: weight windows set, volume importances ignored"
+		 << G4endl;
+	splitting = new WLGDBiasWeightWindow("neutron", fWeightWindows);
+	G4cout << " >>> Detector: " << fWeightWindows.size()
+	       << " neutron weight window(s) set" << G4endl;
+      }
+    else if(!fImportances.empty())
+      {
+	splitting = new WLGDBiasImportanceSplitting("neutron", fImportances);
+	G4cout << " >>> Detector: neutron importance set for " << fImportances.size()
+	       << " volume(s)" << G4endl;
+      }
+
+    if(splitting != nullptr)
+      {
+	sharedOperators.emplace_back(splitting);
+	biasnXS->SetNonPhysicsOperator(splitting);
+	biasmuXS->SetNonPhysicsOperator(splitting);
+      }
+
+    // -- Implicit neutron capture, consulted before the XS operators; it acts
+    // -- only in its own volumes
+    G4VBiasingOperator* implicitCapture = nullptr;
+    if(!fImplicitCaptureVolumes.empty())
+      {
+	implicitCapture = new WLGDBiasImplicitCapture("neutron", fImplicitCaptureVolumes,
+						      fImplicitCaptureFloor,
+						      fImplicitCaptureSurvival);
+	sharedOperators.emplace_back(implicitCapture);
+	biasmuXS->SetParticleOperator("neutron", implicitCapture);
+	if(fForcedCapture == 0)
+	  biasnXS->SetParticleOperator("neutron", implicitCapture);
+	G4cout << " >>> Detector: implicit neutron capture in "
+	       << fImplicitCaptureVolumes.size() << " volume(s)" << G4endl;
+      }
+
+    // -- Volumes without an operator so far get one carrying the splitting, the
+    // -- implicit capture and the factor overrides only
+    if(splitting != nullptr || implicitCapture != nullptr || !overrideParticles.empty())
+      {
+	auto* biasOther = new WLGDBiasMultiParticleChangeCrossSection();
+	biasOther->SetFactorTable(&fBiasFactors);
+	biasOther->SetNonPhysicsOperator(splitting);
+	if(implicitCapture != nullptr)
+	  biasOther->SetParticleOperator("neutron", implicitCapture);
+	for(const G4String& particle : overrideParticles)
+	  biasOther->AddParticle(particle, true);
+	for(G4LogicalVolume* volume : *volumeStore)
+	  {
+	    if(G4VBiasingOperator::GetBiasingOperator(volume) == nullptr)
+	      biasOther->AttachTo(volume);
+	  }
+      }
   }//if(!fSD.Get())
   
   //else
@@ -1675,11 +1895,95 @@ void WLGDDetectorConstruction::ExportGeometry(const G4String& file)
 
 
 
-void WLGDDetectorConstruction::SetNeutronBiasFactor(G4double nf) { fNeutronBias = nf; }
+void WLGDDetectorConstruction::SetNeutronBiasFactor(G4double nf)
+{
+  fBiasFactors.neutronBias = nf;
+}
+
+void WLGDDetectorConstruction::SetMuonBiasFactor(G4double mf) { fBiasFactors.muonBias = mf; }
+
+void WLGDDetectorConstruction::SetNeutronYieldBias(G4double nf)
+{
+  fBiasFactors.neutronYieldBias = nf;
+}
+
+void WLGDDetectorConstruction::SetImportance(const G4String& volume, G4double importance)
+{
+  if(importance <= 0.)
+  {
+    G4ExceptionDescription ed;
+    ed << "Importance " << importance << " of `" << volume
+       << "' is not positive, ignored." << G4endl;
+    G4Exception("WLGDDetectorConstruction::SetImportance", "MyCode0007", JustWarning,
+                ed);
+    return;
+  }
+  fImportances[volume] = importance;
+}
+
+void WLGDDetectorConstruction::SetForcedCapture(G4int answer)
+{
+  fForcedCapture = answer;
+}
+
+void WLGDDetectorConstruction::AddImplicitCapture(const G4String& volume)
+{
+  if(std::find(fImplicitCaptureVolumes.begin(), fImplicitCaptureVolumes.end(), volume) ==
+     fImplicitCaptureVolumes.end())
+    fImplicitCaptureVolumes.push_back(volume);
+}
 
-void WLGDDetectorConstruction::SetMuonBiasFactor(G4double mf) { fMuonBias = mf; }
+void WLGDDetectorConstruction::SetImplicitCaptureWeights(G4double weightFloor,
+                                                         G4double survivalWeight)
+{
+  if(weightFloor <= 0. || survivalWeight <= weightFloor)
+  {
+    G4ExceptionDescription ed;
+    ed << "Implicit capture weight floor " << weightFloor << " and survival weight "
+       << survivalWeight << " need 0 < floor < survival weight, ignored." << G4endl;
+    G4Exception("WLGDDetectorConstruction::SetImplicitCaptureWeights", "MyCode0009",
+                JustWarning, ed);
+    return;
+  }
+  fImplicitCaptureFloor    = weightFloor;
+  fImplicitCaptureSurvival = survivalWeight;
+}
 
-void WLGDDetectorConstruction::SetNeutronYieldBias(G4double nf) { fNeutronYieldBias = nf; }
+void WLGDDetectorConstruction::SetExpTransformStrength(G4double strength)
+{
+  if(strength < 0. || strength >= 1.)
+  {
+    G4ExceptionDescription ed;
+    ed << "Exponential transform strength " << strength
+       << " is not in [0, 1), ignored." << G4endl;
+    G4Exception("WLGDDetectorConstruction::SetExpTransformStrength", "MyCode0010",
+                JustWarning, ed);
+    return;
+  }
+  fBiasFactors.transformStrength = strength;
+}
+
+void WLGDDetectorConstruction::SetBiasFactor(WLGDBiasChangeCrossSection::FactorOverride entry)
+{
+  if(entry.factor <= 0.)
+  {
+    G4ExceptionDescription ed;
+    ed << "Bias factor " << entry.factor << " for " << entry.particle << " "
+       << entry.process << " in " << entry.volume << " is not positive, ignored."
+       << G4endl;
+    G4Exception("WLGDDetectorConstruction::SetBiasFactor", "MyCode0008", JustWarning,
+                ed);
+    return;
+  }
+  fBiasFactors.overrides.push_back(entry);
+}
+
+void WLGDDetectorConstruction::ClearBiasFactors() { fBiasFactors.overrides.clear(); }
+
+void WLGDDetectorConstruction::SetWeightWindowFile(const G4String& fileName)
+{
+  fWeightWindows = WLGDBiasWeightWindow::ReadWindows(fileName);
+}
 
 
 // Additional settings for adjusting the detector geometry
@@ -2004,18 +2308,89 @@ void WLGDDetectorConstruction::DefineCommands()
     ->DeclareMethod("setNeutronBias", &WLGDDetectorConstruction::SetNeutronBiasFactor)
     .SetGuidance("Set Bias factor for neutron capture process.")
     .SetDefaultValue("1.0")
-    .SetStates(G4State_PreInit)
+    .SetStates(G4State_PreInit, G4State_Idle)
     .SetToBeBroadcasted(false);
   fBiasMessenger
     ->DeclareMethod("setMuonBias", &WLGDDetectorConstruction::SetMuonBiasFactor)
     .SetGuidance("Set Bias factor for muon nuclear process.")
     .SetDefaultValue("1.0")
-    .SetStates(G4State_PreInit)
+    .SetStates(G4State_PreInit, G4State_Idle)
     .SetToBeBroadcasted(false);
   fBiasMessenger
     ->DeclareMethod("setNeutronYieldBias", &WLGDDetectorConstruction::SetNeutronYieldBias)
     .SetGuidance("Set Bias factor for neutron yield process.")
     .SetDefaultValue("1.0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fBiasMessenger
+    ->DeclareMethod("setFactor", &WLGDDetectorConstruction::SetBiasFactor)
+    .SetGuidance("Set the cross-section bias factor of a biased process in a volume:")
+    .SetGuidance("  <particle> <process> <logical volume> <factor>")
+    .SetGuidance("where * matches any name, e.g. neutron nCapture Cavern_log 1.")
+    .SetGuidance("Overrides the factors above, the last matching entry wins.")
+    .SetGuidance("Factors may change between runs; new particles need PreInit.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fBiasMessenger->DeclareMethod("clearFactors", &WLGDDetectorConstruction::ClearBiasFactors)
+    .SetGuidance("Remove all factors set by setFactor.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fBiasMessenger
+    ->DeclareMethod("setImportance", &WLGDDetectorConstruction::SetImportance)
+    .SetGuidance("Set the neutron importance of a logical volume, e.g. Lar_log 8.")
+    .SetGuidance("Neutrons are split entering a volume of higher importance and")
+    .SetGuidance("rouletted entering one of lower importance. Unset volumes have 1.")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+  fBiasMessenger
+    ->DeclareMethod("setWeightWindowFile", &WLGDDetectorConstruction::SetWeightWindowFile)
+    .SetGuidance("Read neutron weight windows from file, one per line:")
+    .SetGuidance("  <volume or region> <Emin/MeV> <Emax/MeV> <wLow> <wUp> [<wSurvive>]")
+    .SetGuidance("Neutrons entering a window are split above wUp and rouletted below wLow.")
+    .SetGuidance("wSurvive must lie in [wLow, wUp], by default it is their mean.")
+    .SetGuidance("Weight windows take precedence over volume importances.")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+  fBiasMessenger
+    ->DeclareMethod("setForcedCapture", &WLGDDetectorConstruction::SetForcedCapture)
+    .SetGuidance("Force the capture of neutrons entering a germanium crystal.")
+    .SetGuidance("A weighted clone is captured inside the crystal, the neutron goes")
+    .SetGuidance("on uncollided. Replaces the nCapture bias factor in Ge_log, the")
+    .SetGuidance("factors of the other neutron processes stay.")
+    .SetGuidance("options: 0 [no], 1 [yes]")
+    .SetDefaultValue("0")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+  fBiasMessenger
+    ->DeclareMethod("setExpTransform", &WLGDDetectorConstruction::SetExpTransformStrength)
+    .SetGuidance("Set the strength p in [0, 1) of the neutron exponential transform.")
+    .SetGuidance("The neutron cross-sections are scaled by (1 - p mu), mu being the")
+    .SetGuidance("cosine between the direction and the target point, stretching the")
+    .SetGuidance("paths toward it. Only the biased processes hadElastic,")
+    .SetGuidance("neutronInelastic, nCapture and nFission are scaled, the path to")
+    .SetGuidance("the next interaction is exact only if these are all the neutron")
+    .SetGuidance("interactions of the physics list, as with Shielding.")
+    .SetGuidance("Enable at PreInit, change between runs. Default 0.")
+    .SetDefaultValue("0")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fBiasMessenger
+    ->DeclarePropertyWithUnit("setExpTransformTarget", "m", fBiasFactors.transformTarget,
+                              "Target point of the exponential transform, e.g. the "
+                              "cryostat centre, default the world origin")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+  fBiasMessenger
+    ->DeclareMethod("addImplicitCapture", &WLGDDetectorConstruction::AddImplicitCapture)
+    .SetGuidance("Replace the neutron capture in a logical volume by a weight reduction,")
+    .SetGuidance("e.g. Water_log or BoratedPET_Logical. May be repeated.")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+  fBiasMessenger
+    ->DeclareMethod("setImplicitCaptureWeights",
+                    &WLGDDetectorConstruction::SetImplicitCaptureWeights)
+    .SetGuidance("Set the weight floor and the survival weight of the roulette of")
+    .SetGuidance("neutrons in implicit capture volumes, default 0.25 0.5.")
     .SetStates(G4State_PreInit)
     .SetToBeBroadcasted(false);
 
@@ -2029,4 +2404,51 @@ void WLGDDetectorConstruction::DefineCommands()
     .SetDefaultValue("0")
     .SetStates(G4State_PreInit)
     .SetToBeBroadcasted(false);
+
+  // Define one command directory per region using generic messenger class,
+  // e.g. /WLGD/regions/Rock/setCut 1 m
+  for(const G4String& name : { "World", "Rock", "Hall", "Water", "Cryostat", "Inner" })
+  {
+    RegionSettings& settings = fRegionSettings[name];
+    settings.neutronTimeCut  = 2.0 * ms;  // like the former G4NeutronTrackingCut
+    settings.messenger       = new G4GenericMessenger(
+      &settings, "/WLGD/regions/" + name + "/",
+      "Production cut, user limits and neutron cuts of the " + name + " region");
+
+    settings.messenger
+      ->DeclarePropertyWithUnit("setNeutronTimeCut", "ms", settings.neutronTimeCut,
+                                "Kill neutrons beyond this global time, default 2 ms")
+      .SetStates(G4State_PreInit)
+      .SetToBeBroadcasted(false);
+    settings.messenger
+      ->DeclarePropertyWithUnit("setNeutronEkinCut", "eV", settings.neutronEkinCut,
+                                "Kill neutrons below this kinetic energy, default 0")
+      .SetStates(G4State_PreInit)
+      .SetToBeBroadcasted(false);
+
+    // the world keeps the default /run/setCut cut and no user limits
+    if(name == "World")
+      continue;
+
+    settings.messenger
+      ->DeclarePropertyWithUnit("setCut", "mm", settings.productionCut,
+                                "Production cut, default /run/setCut value")
+      .SetStates(G4State_PreInit)
+      .SetToBeBroadcasted(false);
+    settings.messenger
+      ->DeclarePropertyWithUnit("setMaxTime", "ns", settings.maxTime,
+                                "Kill tracks beyond this global time")
+      .SetStates(G4State_PreInit)
+      .SetToBeBroadcasted(false);
+    settings.messenger
+      ->DeclarePropertyWithUnit("setMinEkin", "MeV", settings.minEkin,
+                                "Kill tracks below this kinetic energy (all particles)")
+      .SetStates(G4State_PreInit)
+      .SetToBeBroadcasted(false);
+    settings.messenger
+      ->DeclarePropertyWithUnit("setMinRange", "mm", settings.minRange,
+                                "Kill charged tracks below this remaining range")
+      .SetStates(G4State_PreInit)
+      .SetToBeBroadcasted(false);
+  }
 }//DefineCommands()
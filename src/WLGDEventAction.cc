@@ -1,4 +1,6 @@
 #include "WLGDEventAction.hh"
+#include "WLGDOutputWriter.hh"
+#include "WLGDRunAction.hh"
 #include "WLGDTrajectory.hh"
 #include "g4root.hh"
 
@@ -76,229 +78,14 @@ void WLGDEventAction::BeginOfEventAction(const G4Event*
 
   // -- clearing all the vectors so that every new event saves also the info of the previous ones and our disk do not explode
 
-  nGe77.clear();
-  edep.clear();
-  ekin.clear();
-  htrid.clear();
-  thit.clear();
-  whit.clear();
-  xloc.clear();
-  yloc.clear();
-  zloc.clear();
-
-  Muonxloc.clear();
-  Muonyloc.clear();
-  Muonzloc.clear();
-  Muonxmom.clear();
-  Muonymom.clear();
-  Muonzmom.clear();
-  Muonenergy.clear();
-
-  neutronxloc.clear();
-  neutronyloc.clear();
-  neutronzloc.clear();
-  neutronxmom.clear();
-  neutronymom.clear();
-  neutronzmom.clear();
-  neutrontime.clear();
-  neutronekin.clear();
-  neutronid.clear();
-  neutroneventid.clear();
-  neutronvolume.clear();
+  // -- assign() keeps the capacity, so the table is not reallocated event by event
+  fTrackProvenance.assign(fTrackProvenance.size(), TrackProvenance());
 
-  tmp_mostOuterRadius = 0;
-  out_mostOuterRadius.clear();
-
-  // clear trajectory data
-  trjpdg.clear();
-  trjnpts.clear();
-  nameid.clear();
-  trjxvtx.clear();
-  trjyvtx.clear();
-  trjzvtx.clear();
-  trjxpos.clear();
-  trjypos.clear();
-  trjzpos.clear();
-
-  ReentranceTube.clear();
-  DetectorNumber.clear();
-
-  Multiplicity_prompt.clear();
-  Multiplicity_prompt.push_back(0);
-  Multiplicity_prompt.push_back(0);
-  Multiplicity_prompt.push_back(0);
-  Multiplicity_prompt.push_back(0);
-
-  Multiplicity_delayed.clear();
-  Multiplicity_delayed.push_back(0);
-  Multiplicity_delayed.push_back(0);
-  Multiplicity_delayed.push_back(0);
-  Multiplicity_delayed.push_back(0);
-
-  Multiplicity_delayed_long.clear();
-  Multiplicity_delayed_long.push_back(0);
-  Multiplicity_delayed_long.push_back(0);
-  Multiplicity_delayed_long.push_back(0);
-  Multiplicity_delayed_long.push_back(0);
+  // -- all columns of the record in one pass
+  fRecord.Reset();
 
-  v_EdepPerDetector_prompt.clear();
-
-  v_EdepPerDetector_delayed.clear();
-
-  v_EdepPerDetector_delayed_long.clear();
-
-  v_NDetector_prompt.clear();
-
-  v_NDetector_delayed.clear();
-
-  v_NDetector_delayed_long.clear();
-
-  Multiplicity_prompt_woGd.clear();
-  Multiplicity_prompt_woGd.push_back(0);
-  Multiplicity_prompt_woGd.push_back(0);
-  Multiplicity_prompt_woGd.push_back(0);
-  Multiplicity_prompt_woGd.push_back(0);
-
-  Multiplicity_delayed_woGd.clear();
-  Multiplicity_delayed_woGd.push_back(0);
-  Multiplicity_delayed_woGd.push_back(0);
-  Multiplicity_delayed_woGd.push_back(0);
-  Multiplicity_delayed_woGd.push_back(0);
-
-  v_EdepPerDetector_prompt_woGd.clear();
-
-  v_EdepPerDetector_delayed_woGd.clear();
-
-  v_NDetector_prompt_woGd.clear();
-
-  v_NDetector_delayed_woGd.clear();
-
-  Multiplicity_prompt_onlyGd.clear();
-  Multiplicity_prompt_onlyGd.push_back(0);
-  Multiplicity_prompt_onlyGd.push_back(0);
-  Multiplicity_prompt_onlyGd.push_back(0);
-  Multiplicity_prompt_onlyGd.push_back(0);
-
-  Multiplicity_delayed_onlyGd.clear();
-  Multiplicity_delayed_onlyGd.push_back(0);
-  Multiplicity_delayed_onlyGd.push_back(0);
-  Multiplicity_delayed_onlyGd.push_back(0);
-  Multiplicity_delayed_onlyGd.push_back(0);
-
-  v_EdepPerDetector_prompt_onlyGd.clear();
-
-  v_EdepPerDetector_delayed_onlyGd.clear();
-
-  v_NDetector_prompt_onlyGd.clear();
-
-  v_NDetector_delayed_onlyGd.clear();
-
-  NumberOfNeutronsProducedInEvent.clear();
-  NumberOfNeutronsProducedInEvent.push_back(0);
-
-  v_EdepWater_prompt.clear();
-  v_EdepWater_prompt.push_back(0);
-
-  v_EdepWater_delayed.clear();
-  v_EdepWater_delayed.push_back(0);
-
-  v_MuonVeto_flag.clear();
-  v_MuonVeto_flag.push_back(0);
-
-  v_isIC.clear();
-  v_isIC.push_back(0);
-
-  v_isMetastable.clear();
-  v_isMetastable.push_back(0);
-
-  // v_nCAr_timing.clear();
-  // v_nCAr_x.clear();
-  // v_nCAr_y.clear();
-  // v_nCAr_z.clear();
-  // v_nCAr_A.clear();
-
-  // v_nCGd_timing.clear();
-  // v_nCGd_x.clear();
-  // v_nCGd_y.clear();
-  // v_nCGd_z.clear();
-  // v_nCGd_A.clear();
-
-  v_nCOther_timing.clear();
-  v_nCOther_x.clear();
-  v_nCOther_y.clear();
-  v_nCOther_z.clear();
-  v_nCOther_A.clear();
-  v_nCOther_ZC.clear();
-  v_nCOther_ID.clear();
-  v_nCOther_EventID.clear();
-  v_nCOther_Volume.clear();
-
-  v_prod_timing.clear();
-  v_prod_x.clear();
-  v_prod_y.clear();
-  v_prod_z.clear();
-  v_prod_A.clear();
-  v_prod_ZC.clear();
-  v_prod_parentType.clear();
-
-  TotalEnergyDepositionInLAr_prompt.clear();
-  TotalEnergyDepositionInLAr_prompt.push_back(0);
-  TotalEnergyDepositionInLAr_prompt.push_back(0);
-  TotalEnergyDepositionInLAr_prompt.push_back(0);
-  TotalEnergyDepositionInLAr_prompt.push_back(0);
-
-  TotalEnergyDepositionInGe_prompt.clear();
-  TotalEnergyDepositionInGe_prompt.push_back(0);
-  TotalEnergyDepositionInGe_prompt.push_back(0);
-  TotalEnergyDepositionInGe_prompt.push_back(0);
-  TotalEnergyDepositionInGe_prompt.push_back(0);
-
-  TotalEnergyDepositionInLAr_delayed.clear();
-  TotalEnergyDepositionInLAr_delayed.push_back(0);
-  TotalEnergyDepositionInLAr_delayed.push_back(0);
-  TotalEnergyDepositionInLAr_delayed.push_back(0);
-  TotalEnergyDepositionInLAr_delayed.push_back(0);
-
-  TotalEnergyDepositionInGe_delayed.clear();
-  TotalEnergyDepositionInGe_delayed.push_back(0);
-  TotalEnergyDepositionInGe_delayed.push_back(0);
-  TotalEnergyDepositionInGe_delayed.push_back(0);
-  TotalEnergyDepositionInGe_delayed.push_back(0);
-
-  TotalEnergyDepositionInLAr_delayed_long.clear();
-  TotalEnergyDepositionInLAr_delayed_long.push_back(0);
-  TotalEnergyDepositionInLAr_delayed_long.push_back(0);
-  TotalEnergyDepositionInLAr_delayed_long.push_back(0);
-  TotalEnergyDepositionInLAr_delayed_long.push_back(0);
-
-  TotalEnergyDepositionInGe_delayed_long.clear();
-  TotalEnergyDepositionInGe_delayed_long.push_back(0);
-  TotalEnergyDepositionInGe_delayed_long.push_back(0);
-  TotalEnergyDepositionInGe_delayed_long.push_back(0);
-  TotalEnergyDepositionInGe_delayed_long.push_back(0);
-
-  TotalEnergyDepositionInLAr_after_delayed.clear();
-  TotalEnergyDepositionInLAr_after_delayed.push_back(0);
-  TotalEnergyDepositionInLAr_after_delayed.push_back(0);
-  TotalEnergyDepositionInLAr_after_delayed.push_back(0);
-  TotalEnergyDepositionInLAr_after_delayed.push_back(0);
-
-  TotalEnergyDepositionInGe_after_delayed.clear();
-  TotalEnergyDepositionInGe_after_delayed.push_back(0);
-  TotalEnergyDepositionInGe_after_delayed.push_back(0);
-  TotalEnergyDepositionInGe_after_delayed.push_back(0);
-  TotalEnergyDepositionInGe_after_delayed.push_back(0);
-
-  IndividualEnergyDeposition_Timing.clear();
-  IndividualEnergyDeposition_LArOrGe.clear();
-  IndividualEnergyDeposition_Energy.clear();
-  IndividualEnergyDeposition_Position_x.clear();
-  IndividualEnergyDeposition_Position_y.clear();
-  IndividualEnergyDeposition_Position_z.clear();
-  IndividualEnergyDeposition_ReentranceTube.clear();
-  IndividualEnergyDeposition_ID.clear();
-  IndividualEnergyDeposition_Type.clear();
-  IndividualEnergyDeposition_DetectorNumber.clear();
+  tmp_mostOuterRadius = 0;
+  fNeutrons           = 0;
 
   EdepPerDetector.clear();
   EdepPerDetector_delayed.clear();
@@ -314,43 +101,6 @@ void WLGDEventAction::BeginOfEventAction(const G4Event*
   IDListOfGe77SiblingParticles.clear();
   IDListOfGdSiblingParticles.clear();
 
-  v_Ge77Siblings_timing.clear();
-  v_Ge77Siblings_x.clear();
-  v_Ge77Siblings_y.clear();
-  v_Ge77Siblings_z.clear();
-  v_Ge77Siblings_edep.clear();
-  v_Ge77Siblings_id.clear();
-  v_Ge77Siblings_type.clear();
-  v_Ge77Siblings_whichVolume.clear();
-
-  v_NeutronCaptureSiblings_edep.clear();
-  v_NeutronCaptureSiblings_type.clear();
-
-  v_GdSiblings_timing.clear();
-  v_GdSiblings_x.clear();
-  v_GdSiblings_y.clear();
-  v_GdSiblings_z.clear();
-  v_GdSiblings_edep.clear();
-  v_GdSiblings_id.clear();
-  v_GdSiblings_type.clear();
-  v_GdSiblings_whichVolume.clear();
-
-  v_Ge77mGammaEmission_timing.clear();
-  v_Ge77mGammaEmission_x.clear();
-  v_Ge77mGammaEmission_y.clear();
-  v_Ge77mGammaEmission_z.clear();
-  v_Ge77mGammaEmission_edep.clear();
-  v_Ge77mGammaEmission_id.clear();
-  v_Ge77mGammaEmission_type.clear();
-  v_Ge77mGammaEmission_whichVolume.clear();
-  v_Ge77mGammaEmission_whichGe77.clear();
-
-  v_Muon_WLSR_intersect_x.clear();
-  v_Muon_WLSR_intersect_y.clear();
-  v_Muon_WLSR_intersect_z.clear();
-  v_Muon_WLSR_Edep.clear();
-  v_Muon_WLSR_Edep.push_back(0);
-
   makeMap();
 }
 
@@ -370,32 +120,88 @@ void WLGDEventAction::EndOfEventAction(const G4Event* event)
   //
   auto CrysHC = GetHitsCollection(fHID, event);
 
-  nGe77.push_back(ekin.size());
+  fRecord.Add(WLGDEventRecord::kNGe77, fRecord.Size(WLGDEventRecord::kEkin));
+
+  // -- the event goes to a new output shard if the current one is full
+  if(fRunAction != nullptr)
+    fRunAction->CountShardEvent(eventID);
+
+  // -- the produced neutrons are written for every event, with hits or not
+  if(fRunAction != nullptr)
+    fRunAction->WriteNeutronProductions();
 
-  if(CrysHC->entries() <= 0 && fAllEvents == 0)
+  // -- weighted Ge-77 score: each Ge-77 nucleus with hits counts once, at its weight
+  if(fRunAction != nullptr)
+  {
+    std::vector<G4int> scoredTIDs;
+    G4double           score = 0.;
+    for(G4int i = 0; i < (G4int) CrysHC->entries(); i++)
+    {
+      auto hh = (*CrysHC)[i];
+      if(std::find(scoredTIDs.begin(), scoredTIDs.end(), hh->GetTID()) != scoredTIDs.end())
+        continue;
+      scoredTIDs.push_back(hh->GetTID());
+      score += hh->GetWeight();
+    }
+    fRunAction->addGe77Score(score);
+  }
+
+  if(fRecord.Get(WLGDEventRecord::kEdepWater_prompt, 0) > 120e6)
+    fRecord.Set(WLGDEventRecord::kMuonVeto_flag, 0, 1);
+
+  // -- the event histograms see every event, with hits or not
+  G4int            nofHits = CrysHC->entries();
+  WLGDSkim::Values values;
+  const G4bool     fillHistograms =
+    fRunAction != nullptr &&
+    fRunAction->GetHistograms().HasHistograms(WLGDHistograms::kEvent);
+  if(fillHistograms || fSkim.IsActive())
+    ComputeSkimValues(nofHits, values);
+  if(fillHistograms)
+    fRunAction->GetHistograms().Fill(WLGDHistograms::kEvent, values.data(), 1.);
+
+  if(nofHits <= 0 && fAllEvents == 0)
   {
     return;  // no action on no hit
   }
 
+  // -- only events passing the skim conditions are written
+  if(fSkim.IsActive())
+  {
+    G4bool pass = fSkim.Evaluate(values, fSkimPassed);
+    if(fRunAction != nullptr)
+      fRunAction->addSkimResult(pass, fSkimPassed);
+    if(!pass)
+      return;
+  }
+
+  // -- /WLGD/histo/setNtupleOutput 0: the event ntuple is not booked
+  if(!fRecord.IsBooked() && fOutputWriter == nullptr)
+    return;
+
   // get analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
 
   // fill Hits output from SD
-  G4int nofHits = CrysHC->entries();
 
   for(G4int i = 0; i < nofHits; i++)
   {
     auto hh = (*CrysHC)[i];
 
-    htrid.push_back(hh->GetTID());
-    whit.push_back(hh->GetWeight());
-    thit.push_back(hh->GetTime() / G4Analysis::GetUnitValue("ns"));
-    edep.push_back(hh->GetEdep() / G4Analysis::GetUnitValue("MeV"));
-    xloc.push_back((hh->GetPos()).x() / G4Analysis::GetUnitValue("m"));
-    yloc.push_back((hh->GetPos()).y() / G4Analysis::GetUnitValue("m"));
-    zloc.push_back((hh->GetPos()).z() / G4Analysis::GetUnitValue("m"));
-    ReentranceTube.push_back(hh->GetWhichReentranceTube());
-    DetectorNumber.push_back(hh->GetWhichDetector());
+    fRecord.Add(WLGDEventRecord::kHitID, hh->GetTID());
+    fRecord.Add(WLGDEventRecord::kHitWeight, hh->GetWeight());
+    fRecord.Add(WLGDEventRecord::kHitTime,
+                hh->GetTime() / G4Analysis::GetUnitValue("ns"));
+    fRecord.Add(WLGDEventRecord::kHitEdep,
+                hh->GetEdep() / G4Analysis::GetUnitValue("MeV"));
+    fRecord.Add(WLGDEventRecord::kHitxLoc,
+                (hh->GetPos()).x() / G4Analysis::GetUnitValue("m"));
+    fRecord.Add(WLGDEventRecord::kHityLoc,
+                (hh->GetPos()).y() / G4Analysis::GetUnitValue("m"));
+    fRecord.Add(WLGDEventRecord::kHitzLoc,
+                (hh->GetPos()).z() / G4Analysis::GetUnitValue("m"));
+    fRecord.Add(WLGDEventRecord::kReentranceTube, hh->GetWhichReentranceTube());
+    fRecord.Add(WLGDEventRecord::kDetectorNumber, hh->GetWhichDetector());
   }
 
   for(auto const& x : EdepPerDetector)
@@ -403,10 +209,10 @@ void WLGDEventAction::EndOfEventAction(const G4Event* event)
     if(x.second < 1e4)
       continue;
     int tmp_i = (int) (x.first / 96);
-    Multiplicity_prompt[tmp_i] += 1;
-    v_NDetector_prompt.push_back(x.first);
-    v_EdepPerDetector_prompt.push_back(x.second);
-    IncreaseGeEnergyDeposition(x.second, tmp_i);
+    fRecord.Increase(WLGDEventRecord::kMultiplicity_prompt, tmp_i, 1);
+    fRecord.Add(WLGDEventRecord::kNDetector_prompt, x.first);
+    fRecord.Add(WLGDEventRecord::kEdepPerDetector_prompt, x.second);
+    fRecord.Increase(WLGDEventRecord::kGeEnergyDeposition, tmp_i, x.second);
   }
 
   for(auto const& x : EdepPerDetector_delayed)
@@ -414,10 +220,10 @@ void WLGDEventAction::EndOfEventAction(const G4Event* event)
     if(x.second < 1e4)
       continue;
     int tmp_i = (int) (x.first / 96);
-    Multiplicity_delayed[tmp_i] += 1;
-    v_NDetector_delayed.push_back(x.first);
-    v_EdepPerDetector_delayed.push_back(x.second);
-    IncreaseGeEnergyDeposition_delayed(x.second, tmp_i);
+    fRecord.Increase(WLGDEventRecord::kMultiplicity_delayed, tmp_i, 1);
+    fRecord.Add(WLGDEventRecord::kNDetector_delayed, x.first);
+    fRecord.Add(WLGDEventRecord::kEdepPerDetector_delayed, x.second);
+    fRecord.Increase(WLGDEventRecord::kGeEnergyDeposition_delayed, tmp_i, x.second);
   }
 
   for(auto const& x : EdepPerDetector_delayed_long)
@@ -425,36 +231,33 @@ void WLGDEventAction::EndOfEventAction(const G4Event* event)
     if(x.second < 1e4)
       continue;
     int tmp_i = (int) (x.first / 96);
-    Multiplicity_delayed_long[tmp_i] += 1;
-    v_NDetector_delayed_long.push_back(x.first);
-    v_EdepPerDetector_delayed_long.push_back(x.second);
-    IncreaseGeEnergyDeposition_delayed_long(x.second, tmp_i);
+    fRecord.Increase(WLGDEventRecord::kMultiplicity_delayed_long, tmp_i, 1);
+    fRecord.Add(WLGDEventRecord::kNDetector_delayed_long, x.first);
+    fRecord.Add(WLGDEventRecord::kEdepPerDetector_delayed_long, x.second);
+    fRecord.Increase(WLGDEventRecord::kGeEnergyDeposition_delayed_long, tmp_i, x.second);
   }
 
   for(auto const& x : EdepPerDetector_prompt_woGd)
   {
-    v_NDetector_prompt_woGd.push_back(x.first);
-    v_EdepPerDetector_prompt_woGd.push_back(x.second);
+    fRecord.Add(WLGDEventRecord::kNDetector_prompt_woGd, x.first);
+    fRecord.Add(WLGDEventRecord::kEdepPerDetector_prompt_woGd, x.second);
   }
   for(auto const& x : EdepPerDetector_delayed_woGd)
   {
-    v_NDetector_delayed_woGd.push_back(x.first);
-    v_EdepPerDetector_delayed_woGd.push_back(x.second);
+    fRecord.Add(WLGDEventRecord::kNDetector_delayed_woGd, x.first);
+    fRecord.Add(WLGDEventRecord::kEdepPerDetector_delayed_woGd, x.second);
   }
   for(auto const& x : EdepPerDetector_prompt_onlyGd)
   {
-    v_NDetector_prompt_onlyGd.push_back(x.first);
-    v_EdepPerDetector_prompt_onlyGd.push_back(x.second);
+    fRecord.Add(WLGDEventRecord::kNDetector_prompt_onlyGd, x.first);
+    fRecord.Add(WLGDEventRecord::kEdepPerDetector_prompt_onlyGd, x.second);
   }
   for(auto const& x : EdepPerDetector_delayed_onlyGd)
   {
-    v_NDetector_delayed_onlyGd.push_back(x.first);
-    v_EdepPerDetector_delayed_onlyGd.push_back(x.second);
+    fRecord.Add(WLGDEventRecord::kNDetector_delayed_onlyGd, x.first);
+    fRecord.Add(WLGDEventRecord::kEdepPerDetector_delayed_onlyGd, x.second);
   }
 
-  if(v_EdepWater_prompt[0] > 120e6)
-    v_MuonVeto_flag[0] = 1;
-
   // fill trajectory data if available
   G4TrajectoryContainer* trajectoryContainer = event->GetTrajectoryContainer();
   G4int                  n_trajectories =
@@ -488,23 +291,24 @@ void WLGDEventAction::EndOfEventAction(const G4Event* event)
     }
 
     // store filtered trajectories only
-    for(const int& item : htrid)
+    for(std::size_t hit = 0; hit < fRecord.Size(WLGDEventRecord::kHitID); ++hit)
     {
+      int item = (int) fRecord.Get(WLGDEventRecord::kHitID, hit);
       std::vector<int> res = FilterTrajectories(item, temptid, temppid);
       for(int& idx : res)
       {
-        trjpdg.push_back(temppdg.at(idx));
-        nameid.push_back(GeomID(tempname.at(idx)));
-        trjxvtx.push_back(tempxvtx.at(idx));
-        trjyvtx.push_back(tempyvtx.at(idx));
-        trjzvtx.push_back(tempzvtx.at(idx));
-        trjnpts.push_back(tempnpts.at(idx));
+        fRecord.Add(WLGDEventRecord::kTrjPDG, temppdg.at(idx));
+        fRecord.Add(WLGDEventRecord::kNameID, GeomID(tempname.at(idx)));
+        fRecord.Add(WLGDEventRecord::kTrjXVtx, tempxvtx.at(idx));
+        fRecord.Add(WLGDEventRecord::kTrjYVtx, tempyvtx.at(idx));
+        fRecord.Add(WLGDEventRecord::kTrjZVtx, tempzvtx.at(idx));
+        fRecord.Add(WLGDEventRecord::kTrjEntries, tempnpts.at(idx));
         int start = std::accumulate(tempnpts.begin(), tempnpts.begin() + idx, 0);
         for(int i = start; i < (start + tempnpts.at(idx)); ++i)
         {
-          trjxpos.push_back(tempxpos.at(i));
-          trjypos.push_back(tempypos.at(i));
-          trjzpos.push_back(tempzpos.at(i));
+          fRecord.Add(WLGDEventRecord::kTrjXPos, tempxpos.at(i));
+          fRecord.Add(WLGDEventRecord::kTrjYPos, tempypos.at(i));
+          fRecord.Add(WLGDEventRecord::kTrjZPos, tempzpos.at(i));
         }
       }
     }
@@ -520,17 +324,65 @@ void WLGDEventAction::EndOfEventAction(const G4Event* event)
     tempypos.clear();
     tempzpos.clear();
   }
-  // fill the ntuple
-  analysisManager->AddNtupleRow();
+  // fill the ntuple, or leave it to the writer thread
+  if(fOutputWriter != nullptr)
+    fOutputWriter->Push(fRecord);
+  else
+    analysisManager->AddNtupleRow(fRecord.GetNtupleID());
 
   // printing
   //  G4int eventID = event->GetEventID();
   /*  G4cout << ">>> Event: " << eventID << G4endl;
-    G4cout << "    " << edep.size() << " hits stored in this event." << G4endl;
-    G4cout << "    " << trjpdg.size() << " trajectories stored in this event." <<
+    G4cout << "    " << fRecord.Size(WLGDEventRecord::kHitEdep)
+           << " hits stored in this event." << G4endl;
+    G4cout << "    " << fRecord.Size(WLGDEventRecord::kTrjPDG)
+           << " trajectories stored in this event." <<
     G4endl;*/
 }
 
+void WLGDEventAction::ComputeSkimValues(G4int nofHits, WLGDSkim::Values& values) const
+{
+  values.fill(0.);
+  values[WLGDSkim::kHits]  = nofHits;
+  values[WLGDSkim::kNGe77] = fRecord.Size(WLGDEventRecord::kEkin);
+
+  // -- detectors above 10 keV, as for the Multiplicity columns; deposits in eV
+  for(auto const& x : EdepPerDetector)
+  {
+    if(x.second < 1e4)
+      continue;
+    values[WLGDSkim::kMultiplicityPrompt] += 1;
+    values[WLGDSkim::kGeEnergyPrompt] += x.second / 1e3;
+  }
+  for(auto const& x : EdepPerDetector_delayed)
+  {
+    if(x.second < 1e4)
+      continue;
+    values[WLGDSkim::kMultiplicityDelayed] += 1;
+    values[WLGDSkim::kGeEnergyDelayed] += x.second / 1e3;
+  }
+  for(auto const& x : EdepPerDetector_delayed_long)
+  {
+    if(x.second >= 1e4)
+      values[WLGDSkim::kMultiplicityDelayedLong] += 1;
+  }
+
+  for(std::size_t tube = 0; tube < fRecord.Size(WLGDEventRecord::kLArEnergyDeposition);
+      ++tube)
+  {
+    values[WLGDSkim::kLArEnergyPrompt] +=
+      fRecord.Get(WLGDEventRecord::kLArEnergyDeposition, tube) / 1e3;
+    values[WLGDSkim::kLArEnergyDelayed] +=
+      fRecord.Get(WLGDEventRecord::kLArEnergyDeposition_delayed, tube) / 1e3;
+  }
+  values[WLGDSkim::kWaterEnergyPrompt] =
+    fRecord.Get(WLGDEventRecord::kEdepWater_prompt, 0) / 1e3;
+  values[WLGDSkim::kWaterEnergyDelayed] =
+    fRecord.Get(WLGDEventRecord::kEdepWater_delayed, 0) / 1e3;
+  values[WLGDSkim::kMuonVeto] = fRecord.Get(WLGDEventRecord::kMuonVeto_flag, 0);
+  values[WLGDSkim::kNeutrons] = fNeutrons;
+}
+
 void WLGDEventAction::SaveAllEvents(G4int answer) { fAllEvents = answer; }
 void WLGDEventAction::SaveAllProductions(G4int answer) { fAllProductions = answer; }
 
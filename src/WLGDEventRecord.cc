@@ -0,0 +1,141 @@
+#include "WLGDEventRecord.hh"
+#include "g4root.hh"
+
+#include "G4ios.hh"
+
+WLGDEventRecord::WLGDEventRecord()
+{
+  fGroupEnabled.fill(false);
+  fGroupEnabled[kAlways] = true;
+}
+
+const WLGDEventRecord::ColumnInfo& WLGDEventRecord::GetInfo(G4int column)
+{
+  static const ColumnInfo columns[kNumberOfColumns] = {
+#define WLGD_COLUMN_INFO(id, type, name, unit, size, group)                             \
+  { name, unit, size, type, group },
+    WLGD_EVENT_COLUMNS(WLGD_COLUMN_INFO)
+#undef WLGD_COLUMN_INFO
+  };
+  return columns[column];
+}
+
+void WLGDEventRecord::EnableGroup(Group group, G4bool enable)
+{
+  if(fAllocated)
+  {
+    G4ExceptionDescription msg;
+    msg << "The event ntuple is already booked, its columns can not be changed.";
+    G4Exception("WLGDEventRecord::EnableGroup()", "MyCode0011", JustWarning, msg);
+    return;
+  }
+  if(group != kAlways)
+    fGroupEnabled[group] = enable;
+}
+
+void WLGDEventRecord::Allocate()
+{
+  if(fAllocated)
+    return;
+
+  // -- count first, so that the storage never moves once the ntuple points to it
+  std::size_t nInt = 0, nDouble = 0;
+  for(G4int column = 0; column < kNumberOfColumns; ++column)
+  {
+    const ColumnInfo& info = GetInfo(column);
+    if(!fGroupEnabled[info.group])
+      continue;
+    if(info.type == kInt)
+      ++nInt;
+    else
+      ++nDouble;
+  }
+  fIntColumns.reserve(nInt);
+  fIntSizes.reserve(nInt);
+  fDoubleColumns.reserve(nDouble);
+  fDoubleSizes.reserve(nDouble);
+
+  for(G4int column = 0; column < kNumberOfColumns; ++column)
+  {
+    const ColumnInfo& info = GetInfo(column);
+    if(!fGroupEnabled[info.group])
+      continue;
+
+    Slot& slot = fSlots[column];
+    slot.type  = info.type;
+    if(info.type == kInt)
+    {
+      slot.index = (G4int) fIntColumns.size();
+      fIntColumns.emplace_back(info.size, 0);
+      fIntSizes.push_back(info.size);
+    }
+    else
+    {
+      slot.index = (G4int) fDoubleColumns.size();
+      fDoubleColumns.emplace_back(info.size, 0.);
+      fDoubleSizes.push_back(info.size);
+    }
+  }
+
+  fAllocated = true;
+}
+
+void WLGDEventRecord::Book(const G4String& name, const G4String& title)
+{
+  if(fBooked)
+    return;
+  Allocate();
+
+  auto analysisManager = G4AnalysisManager::Instance();
+  fNtupleID            = analysisManager->CreateNtuple(name, title);
+  for(G4int column = 0; column < kNumberOfColumns; ++column)
+  {
+    const Slot& slot = fSlots[column];
+    if(slot.index < 0)
+      continue;
+    if(slot.type == kInt)
+      analysisManager->CreateNtupleIColumn(GetInfo(column).name, fIntColumns[slot.index]);
+    else
+      analysisManager->CreateNtupleDColumn(GetInfo(column).name,
+                                           fDoubleColumns[slot.index]);
+  }
+  analysisManager->FinishNtuple();
+
+  fBooked = true;
+}
+
+void WLGDEventRecord::Swap(WLGDEventRecord& other)
+{
+  for(std::size_t i = 0; i < fIntColumns.size(); ++i)
+    fIntColumns[i].swap(other.fIntColumns[i]);
+  for(std::size_t i = 0; i < fDoubleColumns.size(); ++i)
+    fDoubleColumns[i].swap(other.fDoubleColumns[i]);
+}
+
+void WLGDEventRecord::Reset()
+{
+  // -- assign() keeps the capacity, so the columns are not reallocated event by event
+  for(std::size_t i = 0; i < fIntColumns.size(); ++i)
+    fIntColumns[i].assign(fIntSizes[i], 0);
+  for(std::size_t i = 0; i < fDoubleColumns.size(); ++i)
+    fDoubleColumns[i].assign(fDoubleSizes[i], 0.);
+}
+
+void WLGDEventRecord::Print() const
+{
+  static const char* groupNames[kNumberOfGroups] = { "always", "AdvancedMultiplicity",
+                                                     "IndividualGeDepositionInfo",
+                                                     "IndividualGdDepositionInfo" };
+
+  G4cout << "Event ntuple columns (name, type, unit, size, switch):" << G4endl;
+  for(G4int column = 0; column < kNumberOfColumns; ++column)
+  {
+    const ColumnInfo& info = GetInfo(column);
+    G4cout << (IsEnabled((Column) column) ? "  + " : "  - ") << info.name << " "
+           << ((info.type == kInt) ? "I" : "D") << " "
+           << ((info.unit[0] != '\0') ? info.unit : "-") << " " << info.size << " "
+           << groupNames[info.group] << G4endl;
+  }
+  if(!fAllocated)
+    G4cout << "(not booked yet, booking happens at the first run)" << G4endl;
+}
@@ -0,0 +1,197 @@
+#include "WLGDHistograms.hh"
+#include "WLGDSkim.hh"
+#include "g4root.hh"
+
+namespace
+{
+  const char* sourceNames[WLGDHistograms::kNumberOfSources] = { "Event", "Capture",
+                                                                "Ge77" };
+  const char* pointNames[WLGDHistograms::kNumberOfPointQuantities] = {
+    "x", "y", "z", "r", "time", "A", "Z", "Ekin"
+  };
+}  // namespace
+
+WLGDHistograms::WLGDHistograms() { DefineCommands(); }
+
+WLGDHistograms::~WLGDHistograms() { delete fMessenger; }
+
+G4bool WLGDHistograms::FindQuantity(const G4String& name, Source& source, G4int& quantity)
+{
+  std::size_t dot = name.find('.');
+  if(dot == std::string::npos)
+    return false;
+  G4String sourceName = name.substr(0, dot);
+  G4String quantityName = name.substr(dot + 1);
+
+  for(G4int i = 0; i < kNumberOfSources; ++i)
+  {
+    if(sourceName != sourceNames[i])
+      continue;
+    source = (Source) i;
+    if(source == kEvent)
+    {
+      for(G4int q = 0; q < WLGDSkim::kNumberOfQuantities; ++q)
+      {
+        if(quantityName == WLGDSkim::GetQuantityName(q))
+        {
+          quantity = q;
+          return true;
+        }
+      }
+      return false;
+    }
+    for(G4int q = 0; q < kNumberOfPointQuantities; ++q)
+    {
+      if(quantityName == pointNames[q])
+      {
+        quantity = q;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void WLGDHistograms::Add(Definition definition)
+{
+  G4ExceptionDescription msg;
+  if(fBooked)
+    msg << "The histograms are booked at the first run, `" << definition.name
+        << "' can not be added any more.";
+  else if(definition.name.empty() || definition.quantities.empty())
+    msg << "A histogram needs a name and up to three axes "
+           "<quantity> <bins> <min> <max>.";
+
+  Histogram histogram;
+  for(std::size_t axis = 0; msg.str().empty() && axis < definition.quantities.size();
+      ++axis)
+  {
+    Source source   = kEvent;
+    G4int  quantity = 0;
+    if(!FindQuantity(definition.quantities[axis], source, quantity))
+      msg << "Unknown quantity `" << definition.quantities[axis]
+          << "', see /WLGD/histo/list.";
+    else if(axis > 0 && source != histogram.source)
+      msg << "The axes of `" << definition.name << "' come from different sources.";
+    else if(definition.bins[axis] < 1 || definition.max[axis] <= definition.min[axis])
+      msg << "Empty axis " << definition.quantities[axis] << " of `" << definition.name
+          << "'.";
+    histogram.source = source;
+    histogram.quantities.push_back(quantity);
+  }
+  if(!msg.str().empty())
+  {
+    G4Exception("WLGDHistograms::Add()", "MyCode0015", JustWarning, msg);
+    return;
+  }
+
+  histogram.definition = std::move(definition);
+  fBySource[histogram.source].push_back(fHistograms.size());
+  fHistograms.push_back(std::move(histogram));
+}
+
+void WLGDHistograms::Clear()
+{
+  if(fBooked)
+  {
+    G4ExceptionDescription msg;
+    msg << "The histograms are booked at the first run, they can not be removed.";
+    G4Exception("WLGDHistograms::Clear()", "MyCode0015", JustWarning, msg);
+    return;
+  }
+  fHistograms.clear();
+  for(auto& indices : fBySource)
+    indices.clear();
+}
+
+void WLGDHistograms::Book()
+{
+  if(fBooked)
+    return;
+  fBooked = true;
+
+  auto analysisManager = G4AnalysisManager::Instance();
+  for(auto& histogram : fHistograms)
+  {
+    const Definition& d     = histogram.definition;
+    G4String          title = d.quantities[0];
+    for(std::size_t axis = 1; axis < d.quantities.size(); ++axis)
+      title += " : " + d.quantities[axis];
+
+    if(d.quantities.size() == 1)
+      histogram.id =
+        analysisManager->CreateH1(d.name, title, d.bins[0], d.min[0], d.max[0]);
+    else if(d.quantities.size() == 2)
+      histogram.id = analysisManager->CreateH2(d.name, title, d.bins[0], d.min[0],
+                                               d.max[0], d.bins[1], d.min[1], d.max[1]);
+    else
+      histogram.id =
+        analysisManager->CreateH3(d.name, title, d.bins[0], d.min[0], d.max[0], d.bins[1],
+                                  d.min[1], d.max[1], d.bins[2], d.min[2], d.max[2]);
+  }
+}
+
+void WLGDHistograms::Fill(Source source, const G4double* values, G4double weight) const
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+  for(std::size_t index : fBySource[source])
+  {
+    const Histogram& histogram = fHistograms[index];
+    const auto&      q         = histogram.quantities;
+    if(q.size() == 1)
+      analysisManager->FillH1(histogram.id, values[q[0]], weight);
+    else if(q.size() == 2)
+      analysisManager->FillH2(histogram.id, values[q[0]], values[q[1]], weight);
+    else
+      analysisManager->FillH3(histogram.id, values[q[0]], values[q[1]], values[q[2]],
+                              weight);
+  }
+}
+
+void WLGDHistograms::List()
+{
+  G4cout << "Histogram quantities:" << G4endl << "  Event.<quantity> (energies in keV):";
+  for(G4int q = 0; q < WLGDSkim::kNumberOfQuantities; ++q)
+    G4cout << " " << WLGDSkim::GetQuantityName(q);
+  G4cout << G4endl << "  Capture.<quantity> and Ge77.<quantity> (m, us, eV):";
+  for(const char* name : pointNames)
+    G4cout << " " << name;
+  G4cout << G4endl << "Histograms:" << G4endl;
+  for(const auto& histogram : fHistograms)
+  {
+    const Definition& d = histogram.definition;
+    G4cout << "  " << d.name;
+    for(std::size_t axis = 0; axis < d.quantities.size(); ++axis)
+      G4cout << " " << d.quantities[axis] << " " << d.bins[axis] << " " << d.min[axis]
+             << " " << d.max[axis];
+    G4cout << G4endl;
+  }
+}
+
+void WLGDHistograms::DefineCommands()
+{
+  fMessenger =
+    new G4GenericMessenger(this, "/WLGD/histo/", "Commands for the run-level histograms");
+
+  fMessenger->DeclareMethod("add", &WLGDHistograms::Add)
+    .SetGuidance("Add a histogram filled during the run and merged over the threads:")
+    .SetGuidance("  <name> <quantity> <bins> <min> <max> [<quantity> ...]")
+    .SetGuidance("with one to three axes from the same source, e.g.")
+    .SetGuidance("  captureRZ Capture.r 100 0 10 Capture.z 100 -10 10")
+    .SetGuidance("Has to be given before the first run; see /WLGD/histo/list.");
+
+  fMessenger->DeclareMethod("clear", &WLGDHistograms::Clear)
+    .SetGuidance("Remove all histograms, before the first run.");
+
+  fMessenger->DeclareProperty("setNtupleOutput", fWriteNtuples)
+    .SetGuidance("Set whether the event ntuple is written next to the histograms.")
+    .SetGuidance("0 = histograms only, the Score ntuple is not booked")
+    .SetGuidance("1 = both")
+    .SetGuidance("Has to be set before the first run.")
+    .SetCandidates("0 1")
+    .SetDefaultValue("1");
+
+  fMessenger->DeclareMethod("list", &WLGDHistograms::List)
+    .SetGuidance("List the quantities and the histograms.")
+    .SetToBeBroadcasted(false);
+}
@@ -0,0 +1,311 @@
+#include "WLGDOutputFile.hh"
+#include "g4root.hh"
+
+#include "G4Threading.hh"
+
+#include "RVersion.h"
+#include "TBranch.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+namespace
+{
+  // -- algorithms of the ROOT version built against, with their ROOT codes
+  struct Algorithm
+  {
+    const char* name;
+    G4int       code;
+  };
+  const Algorithm algorithms[] = { { "ZLIB", 1 },
+                                   { "LZMA", 2 },
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 12, 0)
+                                   { "LZ4", 4 },
+#endif
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 20, 0)
+                                   { "ZSTD", 5 },
+#endif
+  };
+
+  G4double CompressionRatio(Long64_t totBytes, Long64_t zipBytes)
+  {
+    return (zipBytes > 0) ? (G4double) totBytes / zipBytes : 0.;
+  }
+
+  // -- shards closed since the last manifest was written, from all threads
+  std::mutex                         shardMutex;
+  std::vector<WLGDOutputFile::Shard> closedShards;
+}  // namespace
+
+WLGDOutputFile::WLGDOutputFile()
+{
+  // -- the worker threads rewrite their files at the same time
+  ROOT::EnableThreadSafety();
+  DefineCommands();
+}
+
+WLGDOutputFile::~WLGDOutputFile() { delete fMessenger; }
+
+void WLGDOutputFile::Configure() const
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+  // -- the file is compressed once, when it is rewritten with another algorithm
+  analysisManager->SetCompressionLevel((fAlgorithm == "ZLIB") ? fLevel : 0);
+  analysisManager->SetBasketSize(fBasketSize);
+}
+
+void WLGDOutputFile::Finish(const G4String& fileName) const
+{
+  // -- the master of a MT run may not write a file
+  if(fileName.empty() || !std::ifstream(fileName).good())
+    return;
+  if(fAlgorithm != "ZLIB")
+    Recompress(fileName);
+  if(fReport != 0)
+    Report(fileName);
+}
+
+G4String WLGDOutputFile::GetShardFileName(const G4String& name, G4int shard)
+{
+  if(shard < 0)
+    return name;
+  G4String base = name;
+  if(base.size() > 5 && base.substr(base.size() - 5) == ".root")
+    base = base.substr(0, base.size() - 5);
+  char sequence[16];
+  std::snprintf(sequence, sizeof(sequence), "_%04d", shard);
+  return base + sequence + ".root";
+}
+
+G4bool WLGDOutputFile::IsShardFull(G4int events, const G4String& fileName) const
+{
+  if(fShardEvents > 0 && events >= fShardEvents)
+    return true;
+  // -- the size on disk, which lags by the baskets still in memory
+  struct stat status;
+  return fShardBytes > 0. && stat(fileName.c_str(), &status) == 0 &&
+         status.st_size >= fShardBytes;
+}
+
+void WLGDOutputFile::AddShard(const Shard& shard)
+{
+  std::lock_guard<std::mutex> lock(shardMutex);
+  closedShards.push_back(shard);
+}
+
+void WLGDOutputFile::WriteManifest(const G4String& name)
+{
+  std::lock_guard<std::mutex> lock(shardMutex);
+  if(closedShards.empty())
+    return;
+  std::sort(closedShards.begin(), closedShards.end(), [](const Shard& a, const Shard& b) {
+    return std::tie(a.run, a.thread, a.shard) < std::tie(b.run, b.thread, b.shard);
+  });
+
+  G4String manifestName = name;
+  if(manifestName.size() > 5 && manifestName.substr(manifestName.size() - 5) == ".root")
+    manifestName = manifestName.substr(0, manifestName.size() - 5);
+  manifestName += ".manifest";
+
+  // -- appended run by run; a shard written again, as after a resumed
+  // -- checkpoint, is listed again under the same file name
+  G4bool        isNew = !std::ifstream(manifestName).good();
+  std::ofstream manifest(manifestName, std::ios::app);
+  if(isNew)
+    manifest << "# file run shard thread first_event last_event events\n";
+  for(const auto& shard : closedShards)
+    manifest << shard.file << " " << shard.run << " " << shard.shard << " "
+             << shard.thread << " " << shard.firstEvent << " " << shard.lastEvent << " "
+             << shard.events << "\n";
+  G4cout << "Output shards: " << closedShards.size() << " listed in " << manifestName
+         << G4endl;
+  closedShards.clear();
+}
+
+void WLGDOutputFile::SetShardEvery(const G4String& limit)
+{
+  std::istringstream in(limit);
+  G4double           value = 0.;
+  G4String           unit  = "events";
+  in >> value >> unit;
+
+  G4double scale = 0.;
+  if(unit == "events")
+    scale = 0.;
+  else if(unit == "B")
+    scale = 1.;
+  else if(unit == "kB")
+    scale = 1e3;
+  else if(unit == "MB")
+    scale = 1e6;
+  else if(unit == "GB")
+    scale = 1e9;
+  else
+  {
+    G4ExceptionDescription msg;
+    msg << "Unknown shard limit `" << limit << "', expected <N> [events] or <size> "
+        << "B|kB|MB|GB.";
+    G4Exception("WLGDOutputFile::SetShardEvery()", "MyCode0018", JustWarning, msg);
+    return;
+  }
+
+  fShardEvents = (scale == 0.) ? std::max((G4int) value, 0) : 0;
+  fShardBytes  = (scale == 0.) ? 0. : std::max(value * scale, 0.);
+}
+
+G4String WLGDOutputFile::GetThreadFileName(const G4String& name, G4bool merged)
+{
+  // -- as Geant4 names the files: <name>[_t<N>].root
+  G4String base = name;
+  if(base.size() > 5 && base.substr(base.size() - 5) == ".root")
+    base = base.substr(0, base.size() - 5);
+  if(G4Threading::IsWorkerThread())
+  {
+    if(merged)
+      return "";
+    base += "_t" + std::to_string(G4Threading::G4GetThreadId());
+  }
+  return base + ".root";
+}
+
+G4int WLGDOutputFile::GetCompressionSettings() const
+{
+  for(const auto& algorithm : algorithms)
+  {
+    if(fAlgorithm == algorithm.name)
+      return 100 * algorithm.code + fLevel;
+  }
+  return 100 + fLevel;
+}
+
+void WLGDOutputFile::Recompress(const G4String& fileName) const
+{
+  TFile in(fileName.c_str(), "READ");
+  if(in.IsZombie())
+    return;
+
+  G4String tmpName = fileName + ".tmp";
+  TFile    out(tmpName.c_str(), "RECREATE", in.GetTitle(), GetCompressionSettings());
+
+  // -- every object once, in its last cycle
+  std::set<std::string> done;
+  TIter                 next(in.GetListOfKeys());
+  while(auto* key = static_cast<TKey*>(next()))
+  {
+    if(!done.insert(key->GetName()).second)
+      continue;
+    TObject* object = in.Get(key->GetName());
+    out.cd();
+    if(auto* tree = dynamic_cast<TTree*>(object))
+    {
+      TTree* copy = tree->CloneTree(0);
+      copy->SetBasketSize("*", fBasketSize);
+      copy->CopyEntries(tree);
+      copy->Write();
+    }
+    else if(object != nullptr)
+    {
+      object->Write(key->GetName());
+    }
+  }
+  out.Close();
+  in.Close();
+
+  if(std::rename(tmpName.c_str(), fileName.c_str()) != 0)
+  {
+    G4ExceptionDescription msg;
+    msg << "Could not replace " << fileName << " by its " << fAlgorithm
+        << " compressed copy " << tmpName;
+    G4Exception("WLGDOutputFile::Recompress()", "MyCode0013", JustWarning, msg);
+  }
+}
+
+void WLGDOutputFile::Report(const G4String& fileName) const
+{
+  TFile file(fileName.c_str(), "READ");
+  if(file.IsZombie())
+    return;
+
+  G4cout << "Output " << fileName << " (" << fAlgorithm << " level " << fLevel
+         << ", basket size " << fBasketSize << " B): " << file.GetSize() << " B"
+         << G4endl;
+  std::set<std::string> done;
+  TIter                 next(file.GetListOfKeys());
+  while(auto* key = static_cast<TKey*>(next()))
+  {
+    auto* tree = dynamic_cast<TTree*>(file.Get(key->GetName()));
+    if(tree == nullptr || !done.insert(key->GetName()).second)
+      continue;
+
+    G4cout << "  " << tree->GetName() << ", " << tree->GetEntries()
+           << " entries (column, bytes, compressed bytes, ratio):" << G4endl;
+    TIter nextBranch(tree->GetListOfBranches());
+    while(auto* branch = static_cast<TBranch*>(nextBranch()))
+    {
+      Long64_t totBytes = branch->GetTotBytes("*");
+      Long64_t zipBytes = branch->GetZipBytes("*");
+      G4cout << "    " << branch->GetName() << " " << totBytes << " " << zipBytes << " "
+             << CompressionRatio(totBytes, zipBytes) << G4endl;
+    }
+    G4cout << "    total " << tree->GetTotBytes() << " " << tree->GetZipBytes() << " "
+           << CompressionRatio(tree->GetTotBytes(), tree->GetZipBytes()) << G4endl;
+  }
+}
+
+void WLGDOutputFile::DefineCommands()
+{
+  G4String candidates;
+  for(const auto& algorithm : algorithms)
+    candidates += G4String(candidates.empty() ? "" : " ") + algorithm.name;
+
+  fMessenger = new G4GenericMessenger(
+    this, "/WLGD/output/", "Commands for the compression and shards of the output");
+
+  fMessenger->DeclareProperty("setCompression", fAlgorithm)
+    .SetGuidance("Set the compression algorithm of the output file.")
+    .SetGuidance("Geant4 writes ZLIB, the file is rewritten with ROOT at the end of each")
+    .SetGuidance("run for the others. The rewrite reads and writes the whole file once")
+    .SetGuidance("more, on the thread that wrote it and after its last event: the output")
+    .SetGuidance("I/O doubles, the uncompressed file needs its disk space meanwhile, and")
+    .SetGuidance("the threads finish one rewrite later. Worth it for files kept long.")
+    .SetCandidates(candidates)
+    .SetDefaultValue("ZLIB");
+
+  fMessenger->DeclareProperty("setCompressionLevel", fLevel)
+    .SetGuidance("Set the compression level, 0 = no compression.")
+    .SetParameterName("level", false)
+    .SetRange("level >= 0 && level <= 9")
+    .SetDefaultValue("1");
+
+  fMessenger->DeclareProperty("setBasketSize", fBasketSize)
+    .SetGuidance("Set the basket size of the ntuple columns in bytes.")
+    .SetParameterName("bytes", false)
+    .SetRange("bytes >= 1000")
+    .SetDefaultValue("32000");
+
+  fMessenger->DeclareProperty("report", fReport)
+    .SetGuidance("Print the bytes written per column and the compression ratio at the")
+    .SetGuidance("end of each run, for the file of each thread.")
+    .SetGuidance("0 = don't")
+    .SetGuidance("1 = do")
+    .SetCandidates("0 1")
+    .SetDefaultValue("0");
+
+  fMessenger->DeclareMethod("shardEvery", &WLGDOutputFile::SetShardEvery)
+    .SetGuidance("Rotate the file of each thread into a new shard, <output>_<NNNN>.root,")
+    .SetGuidance("after the given number of its events or once it reaches the size:")
+    .SetGuidance("  <N> [events] or <size> B|kB|MB|GB, 0 for a single file per run")
+    .SetGuidance("The shards are listed with their event ranges in <output>.manifest.")
+    .SetGuidance("Has to be set before the first run; not with merged ntuples.")
+    .SetDefaultValue("0");
+}
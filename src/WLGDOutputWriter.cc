@@ -0,0 +1,97 @@
+#include "WLGDOutputWriter.hh"
+#include "g4root.hh"
+
+#include <algorithm>
+
+WLGDOutputWriter::WLGDOutputWriter(const WLGDEventRecord& layout, std::size_t depth)
+: fAnalysisManager(G4AnalysisManager::Instance())
+, fBooked(layout)
+, fPool(std::max<std::size_t>(depth, 1), layout)
+{
+  for(auto& record : fPool)
+    fFree.push_back(&record);
+}
+
+WLGDOutputWriter::~WLGDOutputWriter() { Drain(); }
+
+void WLGDOutputWriter::Book(const G4String& name, const G4String& title)
+{
+  fBooked.Book(name, title);
+}
+
+void WLGDOutputWriter::Start()
+{
+  if(fThread.joinable())
+    return;
+  fStop  = false;
+  fRows  = 0;
+  fWaits = 0;
+  fThread = std::thread(&WLGDOutputWriter::Run, this);
+}
+
+void WLGDOutputWriter::Push(WLGDEventRecord& record)
+{
+  WLGDEventRecord* slot = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(fMutex);
+    if(fFree.empty())
+    {
+      ++fWaits;
+      fFreeCondition.wait(lock, [this] { return !fFree.empty(); });
+    }
+    slot = fFree.front();
+    fFree.pop_front();
+  }
+
+  // -- the slot is owned by this thread until it is queued
+  slot->Swap(record);
+
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fQueued.push_back(slot);
+  }
+  fQueuedCondition.notify_one();
+}
+
+void WLGDOutputWriter::Drain()
+{
+  if(!fThread.joinable())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fQueuedCondition.notify_one();
+  fThread.join();
+}
+
+void WLGDOutputWriter::Run()
+{
+  for(;;)
+  {
+    WLGDEventRecord* slot = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fQueuedCondition.wait(lock, [this] { return fStop || !fQueued.empty(); });
+      // -- stops only once the queue is empty
+      if(fQueued.empty())
+        return;
+      slot = fQueued.front();
+      fQueued.pop_front();
+    }
+
+    // -- the ntuple reads the booked record, the slot gets its old storage
+    fBooked.Swap(*slot);
+    {
+      std::lock_guard<std::mutex> lock(fAnalysisMutex);
+      fAnalysisManager->AddNtupleRow(fBooked.GetNtupleID());
+    }
+    ++fRows;
+
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fFree.push_back(slot);
+    }
+    fFreeCondition.notify_one();
+  }
+}
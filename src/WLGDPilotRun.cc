@@ -0,0 +1,114 @@
+#include "WLGDPilotRun.hh"
+#include "WLGDDetectorConstruction.hh"
+#include "WLGDRunAction.hh"
+
+#include "G4RunManager.hh"
+
+#include <fstream>
+
+WLGDPilotRun::WLGDPilotRun(WLGDDetectorConstruction* detector)
+: fDetector(detector)
+{
+  DefineCommands();
+}
+
+WLGDPilotRun::~WLGDPilotRun() { delete fMessenger; }
+
+void WLGDPilotRun::ClearGrid()
+{
+  fNeutronGrid.clear();
+  fMuonGrid.clear();
+}
+
+void WLGDPilotRun::Run()
+{
+  auto* runManager = G4RunManager::GetRunManager();
+  // -- on the master of a MT run this is the master run action, which merges
+  // -- the scores of all workers
+  const auto* runAction = static_cast<const WLGDRunAction*>(runManager->GetUserRunAction());
+
+  // -- an empty grid keeps the current factor
+  std::vector<G4double> neutronGrid = fNeutronGrid;
+  std::vector<G4double> muonGrid    = fMuonGrid;
+  if(neutronGrid.empty())
+    neutronGrid.push_back(fDetector->GetNeutronBiasFactor());
+  if(muonGrid.empty())
+    muonGrid.push_back(fDetector->GetMuonBiasFactor());
+
+  G4double bestNeutron = neutronGrid.front();
+  G4double bestMuon    = muonGrid.front();
+  G4double bestFOM     = -1.;
+  for(G4double neutronBias : neutronGrid)
+  {
+    for(G4double muonBias : muonGrid)
+    {
+      fDetector->SetNeutronBiasFactor(neutronBias);
+      fDetector->SetMuonBiasFactor(muonBias);
+      runManager->BeamOn(fEvents);
+
+      G4double fom = runAction->GetFigureOfMerit();
+      G4cout << ">>> Pilot: neutron bias " << neutronBias << ", muon bias " << muonBias
+             << ": relative error " << runAction->GetRelativeError() << ", FOM " << fom
+             << G4endl;
+      if(fom > bestFOM)
+      {
+        bestFOM     = fom;
+        bestNeutron = neutronBias;
+        bestMuon    = muonBias;
+      }
+    }
+  }
+
+  // -- keep the best factors for any further run and write them out
+  fDetector->SetNeutronBiasFactor(bestNeutron);
+  fDetector->SetMuonBiasFactor(bestMuon);
+  G4cout << ">>> Pilot: best neutron bias " << bestNeutron << ", muon bias " << bestMuon
+         << ", FOM " << bestFOM << ", written to " << fOutputMacro << G4endl;
+
+  std::ofstream macro(fOutputMacro, std::ios::trunc);
+  macro << "# bias factors from /WLGD/pilot/run: best FOM " << bestFOM << " of "
+        << neutronGrid.size() * muonGrid.size() << " points, " << fEvents
+        << " events each\n";
+  macro << "/WLGD/bias/setNeutronBias " << bestNeutron << "\n";
+  macro << "/WLGD/bias/setMuonBias " << bestMuon << "\n";
+}
+
+void WLGDPilotRun::DefineCommands()
+{
+  fMessenger = new G4GenericMessenger(this, "/WLGD/pilot/",
+                                      "Commands for tuning the bias factors in pilot runs");
+
+  fMessenger->DeclareMethod("addNeutronBias", &WLGDPilotRun::AddNeutronBias)
+    .SetGuidance("Add a neutron capture bias factor to the pilot grid.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("addMuonBias", &WLGDPilotRun::AddMuonBias)
+    .SetGuidance("Add a muon nuclear bias factor to the pilot grid.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("clearGrid", &WLGDPilotRun::ClearGrid)
+    .SetGuidance("Remove all factors from the pilot grid.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("setEvents", fEvents)
+    .SetGuidance("Set the number of events run at each grid point.")
+    .SetParameterName("events", false)
+    .SetRange("events > 1")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("setOutputMacro", fOutputMacro)
+    .SetGuidance("Set the macro file the best bias factors are written to.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("run", &WLGDPilotRun::Run)
+    .SetGuidance("Run every point of the neutron x muon bias grid and write the")
+    .SetGuidance("factors of the best figure of merit 1 / (R^2 T) to the output macro.")
+    .SetGuidance("Each point is a full run and overwrites the output file.")
+    .SetStates(G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
@@ -13,6 +13,7 @@
 
 // std
 #include <fstream>
+#include <iomanip>
 #include <random>
 #include <set>
 /*#include "TH1F.h"
@@ -61,6 +62,7 @@ WLGDPrimaryGeneratorAction::~WLGDPrimaryGeneratorAction()
 void WLGDPrimaryGeneratorAction::OpenFile()
 {
   fInputFile.open(fFileName, std::ifstream::in);
+  fOpenedFile = fFileName;
     if(!(fInputFile.is_open()))
     {  
     G4cerr << "Musung file not valid! Name: " << fFileName << G4endl;
@@ -153,6 +155,7 @@ void WLGDPrimaryGeneratorAction::OpenMUSUNFile()//If using the MUSUNDirectory op
   
   G4cout << "opening file: " << filechar << G4endl;
   fInputFile.open(filechar);
+  fOpenedFile = filechar;
   if(!(fInputFile.is_open()))
     G4cerr << "MUSUN file not valid! Name: " << filechar << G4endl;
 
@@ -160,6 +163,43 @@ void WLGDPrimaryGeneratorAction::OpenMUSUNFile()//If using the MUSUNDirectory op
 
 
 
+void WLGDPrimaryGeneratorAction::SaveState(std::ostream& out)
+{
+  // -- a closed or exhausted input has no position to resume from
+  std::streamoff offset = -1;
+  if(fInputFile.is_open() && fInputFile.good())
+    offset = fInputFile.tellg();
+  out << std::quoted(std::string(fOpenedFile)) << " " << offset << " " << generator;
+}
+
+void WLGDPrimaryGeneratorAction::RestoreState(std::istream& in)
+{
+  std::string    fileName;
+  std::streamoff offset = -1;
+  in >> std::quoted(fileName) >> offset >> generator;
+  if(!in)
+  {
+    G4Exception("WLGDPrimaryGeneratorAction::RestoreState()", "MyCode0016",
+                JustWarning, "Unreadable generator state, the input is not resumed");
+    return;
+  }
+  if(fileName.empty() || offset < 0)
+    return;
+
+  if(fileName != fOpenedFile || !fInputFile.is_open())
+  {
+    if(fInputFile.is_open())
+      fInputFile.close();
+    fInputFile.open(fileName, std::ifstream::in);
+    fOpenedFile = fileName;
+  }
+  fInputFile.clear();
+  fInputFile.seekg(offset);
+  G4cout << "resuming file: " << fileName << " at byte " << offset << G4endl;
+}
+
+
+
 void WLGDPrimaryGeneratorAction::ChangeFileName(G4String newFile)
 {
 
@@ -0,0 +1,23 @@
+#include "WLGDRegionInformation.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+
+WLGDRegionInformation::WLGDRegionInformation(Role role)
+: fRole(role)
+, fNeutronTimeCut(2.0 * ms)  // like the former G4NeutronTrackingCut
+{}
+
+void WLGDRegionInformation::Print() const
+{
+  G4cout << " Region role " << GetRoleName(fRole) << ", neutron time cut "
+         << G4BestUnit(fNeutronTimeCut, "Time") << ", neutron energy cut "
+         << G4BestUnit(fNeutronEkinCut, "Energy") << G4endl;
+}
+
+const char* WLGDRegionInformation::GetRoleName(G4int role)
+{
+  static const char* names[kNumberOfRoles] = { "World", "Rock",     "Hall",
+                                               "Water", "Cryostat", "Inner" };
+  return (role >= 0 && role < kNumberOfRoles) ? names[role] : "Unknown";
+}
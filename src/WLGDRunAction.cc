@@ -1,381 +1,500 @@
 #include "WLGDRunAction.hh"
+#include "WLGDBiasForcedCapture.hh"
+#include "WLGDBiasImplicitCapture.hh"
+#include "WLGDBiasImportanceSplitting.hh"
+#include "WLGDBiasWeightWindow.hh"
+#include "WLGDCheckpoint.hh"
+#include "WLGDDetectorConstruction.hh"
 #include "WLGDEventAction.hh"
+#include "WLGDOutputWriter.hh"
+#include "WLGDPrimaryGeneratorAction.hh"
+#include "WLGDRegionInformation.hh"
+#include "WLGDStackingAction.hh"
 #include "g4root.hh"
 
+#include "G4AccumulableManager.hh"
 #include "G4Run.hh"
 #include "G4RunManager.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
 #include "G4UnitsTable.hh"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
 #include <fstream>
 #include <iostream>
 using namespace std;
 
-WLGDRunAction::WLGDRunAction(WLGDEventAction* eventAction, G4String name)
+namespace
+{
+  // -- CPU time of the calling thread in seconds, so that the times of the
+  // -- workers add up to that of the run
+  G4double ThreadCPUTime()
+  {
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return time.tv_sec + 1e-9 * time.tv_nsec;
+  }
+}  // namespace
+
+WLGDRunAction::WLGDRunAction(WLGDEventAction* eventAction, G4String name,
+                             WLGDDetectorConstruction* detector)
 : G4UserRunAction()
 , fEventAction(eventAction)
+, fDetector(detector)
 , fout(std::move(name))
 {
   DefineCommands();
 
+  // Register accumulables to the accumulable manager
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(&fKilledNeutrons);
+  accumulableManager->RegisterAccumulable(&fStackDecisions);
+  accumulableManager->RegisterAccumulable(&fEventCounts);
+  accumulableManager->RegisterAccumulable(&fSkimCounts);
+  accumulableManager->RegisterAccumulable(&fWeightWindowCounts);
+  accumulableManager->RegisterAccumulable(&fImportanceCounts);
+  accumulableManager->RegisterAccumulable(&fForcedCaptureCounts);
+  accumulableManager->RegisterAccumulable(&fImplicitCaptureCounts);
+  accumulableManager->RegisterAccumulable(fGe77Yield);
+  accumulableManager->RegisterAccumulable(fGe77YieldSquared);
+  accumulableManager->RegisterAccumulable(fScoredEvents);
+  accumulableManager->RegisterAccumulable(fCPUTime);
+
   // Create analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
 
   // Create directories
   analysisManager->SetVerboseLevel(1);
-  analysisManager->SetNtupleMerging(false);
 
-  // -- write out some branches only if the information is also stored
+  // -- the event ntuple is booked at the first run, once the macros have set
+  // -- the switches its optional columns and the merging are written under
+}
 
+WLGDRunAction::~WLGDRunAction()
+{
+  // -- the writer thread drives the analysis manager, it goes first
+  fOutputWriter.reset();
+  delete G4AnalysisManager::Instance();
+}
 
-  // Creating ntuple with vector entries
-  //
-  analysisManager->CreateNtuple("Score", "Hits");
-  analysisManager->CreateNtupleIColumn("NGe77", fEventAction->GetNGe77());
-  analysisManager->CreateNtupleIColumn("HitID", fEventAction->GetHitTID());
-  analysisManager->CreateNtupleDColumn("Edep", fEventAction->GetHitEdep());
-  analysisManager->CreateNtupleDColumn("Time", fEventAction->GetHitTime());
-  analysisManager->CreateNtupleDColumn("Weight", fEventAction->GetHitWeight());
-  analysisManager->CreateNtupleDColumn("Hitxloc", fEventAction->GetHitxLoc());
-  analysisManager->CreateNtupleDColumn("Hityloc", fEventAction->GetHityLoc());
-  analysisManager->CreateNtupleDColumn("Hitzloc", fEventAction->GetHitzLoc());
-
-  analysisManager->CreateNtupleDColumn("Muonxloc", fEventAction->GetMuonxLoc());
-  analysisManager->CreateNtupleDColumn("Muonyloc", fEventAction->GetMuonyLoc());
-  analysisManager->CreateNtupleDColumn("Muonzloc", fEventAction->GetMuonzLoc());
-  analysisManager->CreateNtupleDColumn("Muonxmom", fEventAction->GetMuonxMom());
-  analysisManager->CreateNtupleDColumn("Muonymom", fEventAction->GetMuonyMom());
-  analysisManager->CreateNtupleDColumn("Muonzmom", fEventAction->GetMuonzMom());
-  analysisManager->CreateNtupleDColumn("MuonEnergy", fEventAction->GetMuonEnergy());
-
-  // Edit: 2021/04/07 by Moritz Neuberger
-  // Adding additional outputs to further investigate situations in which Ge-77 is
-  // produced
-  analysisManager->CreateNtupleDColumn("Ekin", fEventAction->GetHitEkin());
-  analysisManager->CreateNtupleIColumn("ReentranceTube",
-                                       fEventAction->GetReentranceTube());
-  analysisManager->CreateNtupleIColumn("DetectorNumber",
-                                       fEventAction->GetDetectorNumber());
-
-  analysisManager->CreateNtupleDColumn("EdepWater_prompt",
-                                       fEventAction->GetEdepWater_prompt());
-  analysisManager->CreateNtupleDColumn("EdepWater_delayed",
-                                       fEventAction->GetEdepWater_delayed());
-  analysisManager->CreateNtupleIColumn("MunoVeto", fEventAction->GetMuonVeto_flag());
-  analysisManager->CreateNtupleIColumn("isIC", fEventAction->GetisIC());
-  analysisManager->CreateNtupleIColumn("isMetastable", fEventAction->GetisMetastable());
-
-  analysisManager->CreateNtupleDColumn("Neutronxloc", fEventAction->GetNeutronxLoc());
-  analysisManager->CreateNtupleDColumn("Neutronyloc", fEventAction->GetNeutronyLoc());
-  analysisManager->CreateNtupleDColumn("Neutronzloc", fEventAction->GetNeutronzLoc());
-  analysisManager->CreateNtupleDColumn("Neutronxmom", fEventAction->GetNeutronxMom());
-  analysisManager->CreateNtupleDColumn("Neutronymom", fEventAction->GetNeutronyMom());
-  analysisManager->CreateNtupleDColumn("Neutronzmom", fEventAction->GetNeutronzMom());
-  analysisManager->CreateNtupleDColumn("NeutronTime", fEventAction->GetNeutronTime());
-  analysisManager->CreateNtupleDColumn("NeutronEkin", fEventAction->GetNeutronEkin());
-  analysisManager->CreateNtupleDColumn("NeutronID", fEventAction->GetNeutronID());
-  analysisManager->CreateNtupleDColumn("NeutronEventID", fEventAction->GetNeutronEventID());
-  analysisManager->CreateNtupleDColumn("NeutronVolume", fEventAction->GetNeutronVolume());
-  analysisManager->CreateNtupleIColumn("NeutronsInEvent",
-                                       fEventAction->GetNumberOfNeutronsInEvent());
-  analysisManager->CreateNtupleDColumn("NeutronsMostOuterRadius",
-                                       fEventAction->GetNeutronsMostOuterRadius());
-  /*
-    analysisManager->CreateNtupleDColumn("Neutronxtrack",
-    fEventAction->GetNeutronxTrack());
-    analysisManager->CreateNtupleDColumn("Neutronytrack",
-    fEventAction->GetNeutronyTrack());
-    analysisManager->CreateNtupleDColumn("Neutronztrack",
-    fEventAction->GetNeutronzTrack());
-  */
-  analysisManager->CreateNtupleDColumn("LArEnergyDeposition",
-                                       fEventAction->GetLArEnergyDeposition());
-  analysisManager->CreateNtupleDColumn("GeEnergyDeposition",
-                                       fEventAction->GetGeEnergyDeposition());
-  analysisManager->CreateNtupleDColumn("LArEnergyDeposition_delayed",
-                                       fEventAction->GetLArEnergyDeposition_delayed());
-  analysisManager->CreateNtupleDColumn("GeEnergyDeposition_delayed",
-                                       fEventAction->GetGeEnergyDeposition_delayed());
-  if(fWriteOutAdvancedMultiplicity)
-    analysisManager->CreateNtupleDColumn(
-      "LArEnergyDeposition_delayed_long",
-      fEventAction->GetLArEnergyDeposition_delayed_long());
-  if(fWriteOutAdvancedMultiplicity)
-    analysisManager->CreateNtupleDColumn(
-      "GeEnergyDeposition_delayed_long",
-      fEventAction->GetGeEnergyDeposition_delayed_long());
-  if(fWriteOutAdvancedMultiplicity)
-    analysisManager->CreateNtupleDColumn(
-      "LArEnergyDeposition_after_delayed",
-      fEventAction->GetLArEnergyDeposition_after_delayed());
-  if(fWriteOutAdvancedMultiplicity)
-    analysisManager->CreateNtupleDColumn(
-      "GeEnergyDeposition_after_delayed",
-      fEventAction->GetGeEnergyDeposition_after_delayed());
-
-  analysisManager->CreateNtupleDColumn(
-    "IndividualEnergyDeposition_Timing",
-    fEventAction->GetIndividualEnergyDeposition_Timing());
-  analysisManager->CreateNtupleDColumn(
-    "IndividualEnergyDeposition_Energy",
-    fEventAction->GetIndividualEnergyDeposition_Energy());
-  analysisManager->CreateNtupleDColumn(
-    "IndividualEnergyDeposition_Position_x",
-    fEventAction->GetIndividualEnergyDeposition_Position_x());
-  analysisManager->CreateNtupleDColumn(
-    "IndividualEnergyDeposition_Position_y",
-    fEventAction->GetIndividualEnergyDeposition_Position_y());
-  analysisManager->CreateNtupleDColumn(
-    "IndividualEnergyDeposition_Position_z",
-    fEventAction->GetIndividualEnergyDeposition_Position_z());
-  analysisManager->CreateNtupleIColumn(
-    "IndividualEnergyDeposition_ReentranceTube",
-    fEventAction->GetIndividualEnergyDeposition_ReentranceTube());
-  analysisManager->CreateNtupleIColumn(
-    "IndividualEnergyDeposition_Volume",
-    fEventAction->GetIndividualEnergyDeposition_LArOrGe());
-  analysisManager->CreateNtupleIColumn("IndividualEnergyDeposition_ID",
-                                       fEventAction->GetIndividualEnergyDeposition_ID());
-  analysisManager->CreateNtupleIColumn(
-    "IndividualEnergyDeposition_Type",
-    fEventAction->GetIndividualEnergyDeposition_Type());
-  analysisManager->CreateNtupleIColumn(
-    "IndividualEnergyDeposition_DetectorNumber",
-    fEventAction->GetIndividualEnergyDeposition_DetectorNumber());
-
-  analysisManager->CreateNtupleIColumn("Multiplicity_prompt",
-                                       fEventAction->GetMultiplicity_prompt());
-  analysisManager->CreateNtupleIColumn("Multiplicity_delayed",
-                                       fEventAction->GetMultiplicity_delayed());
-  if(fWriteOutAdvancedMultiplicity)
-    analysisManager->CreateNtupleIColumn("Multiplicity_delayed_long",
-                                         fEventAction->GetMultiplicity_delayed_long());
-  analysisManager->CreateNtupleDColumn("EdepPerDetector_prompt",
-                                       fEventAction->GetEdepPerDetector_prompt());
-  analysisManager->CreateNtupleDColumn("EdepPerDetector_delayed",
-                                       fEventAction->GetEdepPerDetector_delayed());
-  if(fWriteOutAdvancedMultiplicity)
-    analysisManager->CreateNtupleDColumn("EdepPerDetector_delayed_long",
-                                         fEventAction->GetEdepPerDetector_delayed_long());
-  analysisManager->CreateNtupleDColumn("CopyNDetector_prompt",
-                                       fEventAction->GetNDetector_prompt());
-  analysisManager->CreateNtupleDColumn("CopyNDetector_delayed",
-                                       fEventAction->GetNDetector_delayed());
-  if(fWriteOutAdvancedMultiplicity)
-    analysisManager->CreateNtupleDColumn("CopyNDetector_delayed_long",
-                                         fEventAction->GetNDetector_delayed_long());
-
-  if(fWriteOutAdvancedMultiplicity)
-  {
-    //  analysisManager->CreateNtupleIColumn("Multiplicity_prompt_woGd",
-    //  fEventAction->GetMultiplicity_prompt_woGd());
-    //  analysisManager->CreateNtupleIColumn("Multiplicity_delayed_woGd",
-    //  fEventAction->GetMultiplicity_delayed_woGd())
-    analysisManager->CreateNtupleDColumn("EdepPerDetector_prompt_woGd",
-                                         fEventAction->GetEdepPerDetector_prompt_woGd());
-    analysisManager->CreateNtupleDColumn("EdepPerDetector_delayed_woGd",
-                                         fEventAction->GetEdepPerDetector_delayed_woGd());
-    analysisManager->CreateNtupleDColumn("CopyNDetector_prompt_woGd",
-                                         fEventAction->GetNDetector_prompt_woGd());
-    analysisManager->CreateNtupleDColumn("CopyNDetector_delayed_woGd",
-                                         fEventAction->GetNDetector_delayed_woGd());
-
-    //  analysisManager->CreateNtupleIColumn("Multiplicity_prompt_onlyGd",
-    //  fEventAction->GetMultiplicity_prompt_onlyGd());
-    //  analysisManager->CreateNtupleIColumn("Multiplicity_delayed_onlyGd",
-    //  fEventAction->GetMultiplicity_delayed_onlyGd());
-    analysisManager->CreateNtupleDColumn(
-      "EdepPerDetector_prompt_onlyGd", fEventAction->GetEdepPerDetector_prompt_onlyGd());
-    analysisManager->CreateNtupleDColumn(
-      "EdepPerDetector_delayed_onlyGd",
-      fEventAction->GetEdepPerDetector_delayed_onlyGd());
-    analysisManager->CreateNtupleDColumn("CopyNDetector_prompt_onlyGd",
-                                         fEventAction->GetNDetector_prompt_onlyGd());
-    analysisManager->CreateNtupleDColumn("CopyNDetector_delayed_onlyGd",
-                                         fEventAction->GetNDetector_delayed_onlyGd());
-  }
+void WLGDRunAction::BeginOfRunAction(const G4Run* run)
+{
+  // Get analysis manager
+  auto analysisManager = G4AnalysisManager::Instance();
 
-  if(fIndividualGeDepositionInfo)
+  // Book the event ntuple with the columns enabled by the switches; its layout
+  // and merging mode stay the same for the following runs
+  WLGDEventRecord& record = fEventAction->GetRecord();
+  if(!record.IsAllocated())
   {
-    analysisManager->CreateNtupleDColumn("Ge77Siblings_timing",
-                                         fEventAction->GetGe77Siblings_timing());
-    analysisManager->CreateNtupleDColumn("Ge77Siblings_x",
-                                         fEventAction->GetGe77Siblings_x());
-    analysisManager->CreateNtupleDColumn("Ge77Siblings_y",
-                                         fEventAction->GetGe77Siblings_y());
-    analysisManager->CreateNtupleDColumn("Ge77Siblings_z",
-                                         fEventAction->GetGe77Siblings_z());
-    analysisManager->CreateNtupleDColumn("Ge77Siblings_edep",
-                                         fEventAction->GetGe77Siblings_edep());
-    analysisManager->CreateNtupleIColumn("Ge77Siblings_id",
-                                         fEventAction->GetGe77Siblings_id());
-    analysisManager->CreateNtupleIColumn("Ge77Siblings_type",
-                                         fEventAction->GetGe77Siblings_type());
-    analysisManager->CreateNtupleIColumn("Ge77Siblings_whichVolume",
-                                         fEventAction->GetGe77Siblings_whichVolume());
+    // -- merged rows go to the master file as they are filled, column-wise
+    // -- merging would hold the vector columns of whole baskets per thread
+    analysisManager->SetNtupleMerging(fMergeNtuples != 0);
+    if(fMergeNtuples != 0)
+      analysisManager->SetNtupleRowWise(true);
+    record.EnableGroup(WLGDEventRecord::kAdvancedMultiplicity,
+                       fWriteOutAdvancedMultiplicity != 0);
+    record.EnableGroup(WLGDEventRecord::kIndividualGe, fIndividualGeDepositionInfo != 0);
+    record.EnableGroup(WLGDEventRecord::kIndividualGd, fIndividualGdDepositionInfo != 0);
+
+    // -- with a writer thread the event action fills an unbooked record and
+    // -- the writer owns the booked one; the master of MT runs has no events.
+    // -- Without the ntuple the record is still filled, for the histograms.
+    if(!fHistograms.WriteNtuples())
+    {
+      record.Allocate();
+    }
+    else if(fOutputQueueDepth > 0 &&
+            (G4Threading::IsWorkerThread() || !G4Threading::IsMultithreadedApplication()))
+    {
+      record.Allocate();
+      fOutputWriter = std::make_unique<WLGDOutputWriter>(record, fOutputQueueDepth);
+      fOutputWriter->Book("Score", "Hits");
+      fEventAction->SetOutputWriter(fOutputWriter.get());
+    }
+    else
+    {
+      record.Book("Score", "Hits");
+    }
+    BookNeutronNtuples();
+    fHistograms.Book();
+
+    // -- rotating the file of a worker would split the merged rows of the master
+    fSharded = fOutputFile.IsSharded() && fMergeNtuples == 0;
+    if(fOutputFile.IsSharded() && !fSharded)
+    {
+      G4ExceptionDescription msg;
+      msg << "/WLGD/output/shardEvery is ignored with merged ntuples.";
+      G4Exception("WLGDRunAction::BeginOfRunAction()", "MyCode0018", JustWarning, msg);
+    }
+    if(fSharded)
+      BookShardNtuple();
   }
-  //if(fNeutronCaptureSiblings){
-    analysisManager->CreateNtupleIColumn("NeutronCaptureSiblings_type",
-                                         fEventAction->GetNeutronCaptureSiblings_type());
-    analysisManager->CreateNtupleDColumn("NeutronCaptureSiblings_edep",
-                                         fEventAction->GetNeutronCaptureSiblings_edep());
-  //y}
-  if(fIndividualGdDepositionInfo)
+
+  // the generator of this thread continues from a resumed checkpoint
+  if(fPrimaryGenerator != nullptr)
+    WLGDCheckpoint::RestoreThreadState(*fPrimaryGenerator);
+
+  // Open an output file, one shard per run of a checkpointed job
+  //
+  // and one more for each file rotation of the threads with events
+  fRunFileName = WLGDOutputFile::GetShardFileName(fout, WLGDCheckpoint::GetShard());
+  fRunID       = run->GetRunID();
+  fShard       = 0;
+  fShardEvents = 0;
+  fFileName    = fRunFileName;
+  if(fSharded &&
+     (G4Threading::IsWorkerThread() || !G4Threading::IsMultithreadedApplication()))
+    fFileName = WLGDOutputFile::GetShardFileName(fRunFileName, fShard);
+  fOutputFile.Configure();
+  analysisManager->OpenFile(fFileName);
+  if(fOutputWriter != nullptr)
+    fOutputWriter->Start();
+
+  // reset accumulables to their initial values
+  G4AccumulableManager::Instance()->Reset();
+
+  fRunCPUStart = ThreadCPUTime();
+
+  fNumberOfCrossingNeutrons   = 0;
+  fTotalNumberOfNeutronsInLAr = 0;
+  fNeutronProductions.clear();
+}
+
+void WLGDRunAction::BookShardNtuple()
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+
+  // one row per file, its entry of the manifest
+  fShardID = analysisManager->CreateNtuple("Shard", "Events of this output shard");
+  analysisManager->CreateNtupleIColumn("RunID");
+  analysisManager->CreateNtupleIColumn("Shard");
+  analysisManager->CreateNtupleIColumn("Thread");
+  analysisManager->CreateNtupleIColumn("FirstEvent");
+  analysisManager->CreateNtupleIColumn("LastEvent");
+  analysisManager->CreateNtupleIColumn("Events");
+  analysisManager->FinishNtuple();
+}
+
+void WLGDRunAction::CountShardEvent(G4int eventID)
+{
+  if(!fSharded)
+    return;
+  if(fShardEvents > 0 &&
+     fOutputFile.IsShardFull(fShardEvents,
+                             WLGDOutputFile::GetThreadFileName(fFileName, false)))
+    RotateShard();
+
+  if(fShardEvents == 0)
+    fShardFirstEvent = eventID;
+  fShardLastEvent = eventID;
+  ++fShardEvents;
+}
+
+void WLGDRunAction::CloseShard()
+{
+  WLGDOutputFile::Shard shard;
+  shard.file       = WLGDOutputFile::GetThreadFileName(fFileName, false);
+  shard.run        = fRunID;
+  shard.shard      = fShard;
+  shard.thread     = G4Threading::G4GetThreadId();
+  shard.firstEvent = (fShardEvents > 0) ? fShardFirstEvent : -1;
+  shard.lastEvent  = (fShardEvents > 0) ? fShardLastEvent : -1;
+  shard.events     = fShardEvents;
+  WLGDOutputFile::AddShard(shard);
+
+  auto analysisManager = G4AnalysisManager::Instance();
+  analysisManager->FillNtupleIColumn(fShardID, 0, shard.run);
+  analysisManager->FillNtupleIColumn(fShardID, 1, shard.shard);
+  analysisManager->FillNtupleIColumn(fShardID, 2, shard.thread);
+  analysisManager->FillNtupleIColumn(fShardID, 3, shard.firstEvent);
+  analysisManager->FillNtupleIColumn(fShardID, 4, shard.lastEvent);
+  analysisManager->FillNtupleIColumn(fShardID, 5, shard.events);
+  analysisManager->AddNtupleRow(fShardID);
+}
+
+void WLGDRunAction::RotateShard()
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+
+  // the writer thread finishes the rows of the full shard first; the histograms
+  // of a worker are added to the master by Write(), they are not split
+  if(fOutputWriter != nullptr)
+    fOutputWriter->Drain();
+  CloseShard();
+  analysisManager->Write();
+  analysisManager->CloseFile();
+  fOutputFile.Finish(WLGDOutputFile::GetThreadFileName(fFileName, false));
+
+  ++fShard;
+  fShardEvents = 0;
+  fFileName    = WLGDOutputFile::GetShardFileName(fRunFileName, fShard);
+  fOutputFile.Configure();
+  analysisManager->OpenFile(fFileName);
+  if(fOutputWriter != nullptr)
+    fOutputWriter->Start();
+}
+
+void WLGDRunAction::BookNeutronNtuples()
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+
+  // Edit: 2021/03/12 by Moritz Neuberger
+  // Adding detail output for neutron production information, one row per neutron
+  if(fWriteOutNeutronProductionInfo == 1)
   {
-    analysisManager->CreateNtupleDColumn("GdSiblings_timing",
-                                         fEventAction->GetGdSiblings_timing());
-    analysisManager->CreateNtupleDColumn("GdSiblings_x", fEventAction->GetGdSiblings_x());
-    analysisManager->CreateNtupleDColumn("GdSiblings_y", fEventAction->GetGdSiblings_y());
-    analysisManager->CreateNtupleDColumn("GdSiblings_z", fEventAction->GetGdSiblings_z());
-    analysisManager->CreateNtupleDColumn("GdSiblings_edep",
-                                         fEventAction->GetGdSiblings_edep());
-    analysisManager->CreateNtupleIColumn("GdSiblings_id",
-                                         fEventAction->GetGdSiblings_id());
-    analysisManager->CreateNtupleIColumn("GdSiblings_type",
-                                         fEventAction->GetGdSiblings_type());
-    analysisManager->CreateNtupleIColumn("GdSiblings_whichVolume",
-                                         fEventAction->GetGdSiblings_whichVolume());
+    fNeutronProductionID = analysisManager->CreateNtuple("NeutronProduction",
+                                                         "Neutrons produced in the run");
+    analysisManager->CreateNtupleIColumn("EventID");
+    analysisManager->CreateNtupleDColumn("x");
+    analysisManager->CreateNtupleDColumn("y");
+    analysisManager->CreateNtupleDColumn("z");
+    analysisManager->CreateNtupleDColumn("xMom");
+    analysisManager->CreateNtupleDColumn("yMom");
+    analysisManager->CreateNtupleDColumn("zMom");
+    analysisManager->CreateNtupleDColumn("Ekin");
+    analysisManager->CreateNtupleIColumn("ParentPDG");
+    analysisManager->FinishNtuple();
   }
 
-  // analysisManager->CreateNtupleDColumn("nCAr_timing", fEventAction->GetnCAr_timing());
-  // analysisManager->CreateNtupleDColumn("nCAr_x", fEventAction->GetnCAr_x());
-  // analysisManager->CreateNtupleDColumn("nCAr_y", fEventAction->GetnCAr_y());
-  // analysisManager->CreateNtupleDColumn("nCAr_z", fEventAction->GetnCAr_z());
-  // analysisManager->CreateNtupleIColumn("nCAr_A", fEventAction->GetnCAr_A());
-
-  // analysisManager->CreateNtupleDColumn("nCGd_timing", fEventAction->GetnCGd_timing());
-  // analysisManager->CreateNtupleDColumn("nCGd_x", fEventAction->GetnCGd_x());
-  // analysisManager->CreateNtupleDColumn("nCGd_y", fEventAction->GetnCGd_y());
-  // analysisManager->CreateNtupleDColumn("nCGd_z", fEventAction->GetnCGd_z());
-  // analysisManager->CreateNtupleIColumn("nCGd_A", fEventAction->GetnCGd_A());
-
-  analysisManager->CreateNtupleDColumn("nCapture_timing",
-                                       fEventAction->GetnCOther_timing());
-  analysisManager->CreateNtupleDColumn("nCapture_x", fEventAction->GetnCOther_x());
-  analysisManager->CreateNtupleDColumn("nCapture_y", fEventAction->GetnCOther_y());
-  analysisManager->CreateNtupleDColumn("nCapture_z", fEventAction->GetnCOther_z());
-  analysisManager->CreateNtupleIColumn("nCapture_A", fEventAction->GetnCOther_A());
-  analysisManager->CreateNtupleIColumn("nCapture_Z", fEventAction->GetnCOther_ZC());
-  analysisManager->CreateNtupleIColumn("nCapture_ID", fEventAction->GetnCOther_ID());
-  analysisManager->CreateNtupleIColumn("nCapture_EventID", fEventAction->GetnCOther_EventID());
-  analysisManager->CreateNtupleIColumn("nCapture_Volume", fEventAction->GetnCOther_Volume());
-
-  analysisManager->CreateNtupleDColumn("prod_timing",
-                                       fEventAction->Getprod_timing());
-  analysisManager->CreateNtupleDColumn("prod_x", fEventAction->Getprod_x());
-  analysisManager->CreateNtupleDColumn("prod_y", fEventAction->Getprod_y());
-  analysisManager->CreateNtupleDColumn("prod_z", fEventAction->Getprod_z());
-  analysisManager->CreateNtupleIColumn("prod_A", fEventAction->Getprod_A());
-  analysisManager->CreateNtupleIColumn("prod_Z", fEventAction->Getprod_ZC());//prod_parentType
-  analysisManager->CreateNtupleIColumn("prod_parentType", fEventAction->Getprod_parentType());//prod_parentType
-
-
-  if(fIndividualGeDepositionInfo)
+  // Adding output for number of neutrons crossing the detectors and total produced in
+  // LAr, one row per run and thread
+  if(fWriteOutGeneralNeutronInfo == 1)
   {
-    analysisManager->CreateNtupleDColumn("Ge77mGammaEmission_timing",
-                                         fEventAction->GetGe77mGammaEmission_timing());
-    analysisManager->CreateNtupleDColumn("Ge77mGammaEmission_x",
-                                         fEventAction->GetGe77mGammaEmission_x());
-    analysisManager->CreateNtupleDColumn("Ge77mGammaEmission_y",
-                                         fEventAction->GetGe77mGammaEmission_y());
-    analysisManager->CreateNtupleDColumn("Ge77mGammaEmission_z",
-                                         fEventAction->GetGe77mGammaEmission_z());
-    analysisManager->CreateNtupleDColumn("Ge77mGammaEmission_edep",
-                                         fEventAction->GetGe77mGammaEmission_edep());
-    analysisManager->CreateNtupleIColumn("Ge77mGammaEmission_id",
-                                         fEventAction->GetGe77mGammaEmission_id());
-    analysisManager->CreateNtupleIColumn("Ge77mGammaEmission_type",
-                                         fEventAction->GetGe77mGammaEmission_type());
-    analysisManager->CreateNtupleIColumn(
-      "Ge77mGammaEmission_whichVolume",
-      fEventAction->GetGe77mGammaEmission_whichVolume());
-    analysisManager->CreateNtupleIColumn("Ge77mGammaEmission_whichGe77",
-                                         fEventAction->GetGe77mGammaEmission_whichGe77());
+    fRunSummaryID = analysisManager->CreateNtuple("RunSummary", "Neutron counts per run");
+    analysisManager->CreateNtupleIColumn("RunID");
+    analysisManager->CreateNtupleIColumn("Events");
+    analysisManager->CreateNtupleIColumn("NeutronCrossings");
+    analysisManager->CreateNtupleIColumn("NeutronsInLAr");
+    analysisManager->FinishNtuple();
   }
-  // GetnCAr_timing
-  analysisManager->CreateNtupleIColumn("Trjpdg", fEventAction->GetTrjPDG());
-  analysisManager->CreateNtupleIColumn("Trjentries", fEventAction->GetTrjEntries());
-  analysisManager->CreateNtupleIColumn("VtxName", fEventAction->GetNameID());
-  analysisManager->CreateNtupleDColumn("TrjXVtx", fEventAction->GetTrjXVtx());
-  analysisManager->CreateNtupleDColumn("TrjYVtx", fEventAction->GetTrjYVtx());
-  analysisManager->CreateNtupleDColumn("TrjZVtx", fEventAction->GetTrjZVtx());
-  analysisManager->CreateNtupleDColumn("TrjXPos", fEventAction->GetTrjXPos());
-  analysisManager->CreateNtupleDColumn("TrjYPos", fEventAction->GetTrjYPos());
-  analysisManager->CreateNtupleDColumn("TrjZPos", fEventAction->GetTrjZPos());
-
-  analysisManager->CreateNtupleDColumn("Muon_WLSR_intersect_x", fEventAction->Get_Muon_WLSR_intersect_x());
-  analysisManager->CreateNtupleDColumn("Muon_WLSR_intersect_y", fEventAction->Get_Muon_WLSR_intersect_y());
-  analysisManager->CreateNtupleDColumn("Muon_WLSR_intersect_z", fEventAction->Get_Muon_WLSR_intersect_z());
-  analysisManager->CreateNtupleDColumn("Muon_WLSR_Edep", fEventAction->Get_Muon_WLSR_Edep());
-
-  analysisManager->FinishNtuple();
 }
 
-WLGDRunAction::~WLGDRunAction() { delete G4AnalysisManager::Instance(); }
+void WLGDRunAction::addNeutronProduction(G4int eventID, const G4ThreeVector& position,
+                                         const G4ThreeVector& direction, G4double ekin,
+                                         G4int parentPDG)
+{
+  if(fNeutronProductionID < 0)
+    return;
+  fNeutronProductions.push_back({ eventID, position, direction, ekin, parentPDG });
+}
 
-void WLGDRunAction::BeginOfRunAction(const G4Run* /*run*/)
+void WLGDRunAction::WriteNeutronProductions()
 {
-  // Get analysis manager
+  if(fNeutronProductions.empty())
+    return;
+
+  // -- the writer thread may be adding an event row at the same time
+  std::unique_lock<std::mutex> lock;
+  if(fOutputWriter != nullptr)
+    lock = fOutputWriter->LockAnalysisManager();
+
   auto analysisManager = G4AnalysisManager::Instance();
-  // Open an output file
-  //
-  analysisManager->OpenFile(fout);
+  for(const auto& production : fNeutronProductions)
+  {
+    analysisManager->FillNtupleIColumn(fNeutronProductionID, 0, production.eventID);
+    analysisManager->FillNtupleDColumn(fNeutronProductionID, 1, production.position.x());
+    analysisManager->FillNtupleDColumn(fNeutronProductionID, 2, production.position.y());
+    analysisManager->FillNtupleDColumn(fNeutronProductionID, 3, production.position.z());
+    analysisManager->FillNtupleDColumn(fNeutronProductionID, 4, production.direction.x());
+    analysisManager->FillNtupleDColumn(fNeutronProductionID, 5, production.direction.y());
+    analysisManager->FillNtupleDColumn(fNeutronProductionID, 6, production.direction.z());
+    analysisManager->FillNtupleDColumn(fNeutronProductionID, 7, production.ekin);
+    analysisManager->FillNtupleIColumn(fNeutronProductionID, 8, production.parentPDG);
+    analysisManager->AddNtupleRow(fNeutronProductionID);
+  }
+  fNeutronProductions.clear();
+}
 
-  fNumberOfCrossingNeutrons   = 0;
-  fTotalNumberOfNeutronsInLAr = 0;
+std::map<G4String, G4double> WLGDRunAction::GetRunCounters() const
+{
+  return { { "EventsProcessed", fEventCounts.Get(WLGDStackingAction::kEventsProcessed) },
+           { "EventsAborted", fEventCounts.Get(WLGDStackingAction::kEventsAborted) },
+           { "Ge77Yield", fGe77Yield.GetValue() },
+           { "Ge77YieldSquared", fGe77YieldSquared.GetValue() },
+           { "ScoredEvents", (G4double) fScoredEvents.GetValue() },
+           { "CPUTime", fCPUTime.GetValue() },
+           { "SkimTested", fSkimCounts.Get(0) },
+           { "SkimWritten", fSkimCounts.Get(1) } };
+}
 
-  ofstream outputStream;
-  if(fWriteOutGeneralNeutronInfo == 1)
+void WLGDRunAction::addGe77Score(G4double score)
+{
+  fGe77Yield += score;
+  fGe77YieldSquared += score * score;
+  fScoredEvents += 1;
+
+  // running view of this thread, before the merge at end of run
+  if(fFOMReportInterval > 0 && fScoredEvents.GetValue() % fFOMReportInterval == 0)
   {
-    fout2 = fout + "_NCrossing.txt";
-    outputStream.open(fout2.c_str(), ios::trunc);
-    outputStream.close();
+    UpdateFigureOfMerit(ThreadCPUTime() - fRunCPUStart);
+    PrintFigureOfMerit("Running");
   }
+}
 
-  if(fWriteOutNeutronProductionInfo == 1)
+void WLGDRunAction::UpdateFigureOfMerit(G4double cpuTime)
+{
+  fFOMCPUTime    = (cpuTime < 0.) ? fCPUTime.GetValue() : cpuTime;
+  fRelativeError = 0.;
+  fFigureOfMerit = 0.;
+  G4int    n     = fScoredEvents.GetValue();
+  G4double sum   = fGe77Yield.GetValue();
+  if(n > 1 && sum > 0.)
   {
-    fout3 = fout + "_NCreationPosition.txt";
-    outputStream_2.open(fout3.c_str(), ios::trunc);
+    // relative variance of the mean yield, from the per-event scores
+    G4double relativeVariance =
+      std::max(fGe77YieldSquared.GetValue() / (sum * sum) - 1. / n, 0.);
+    fRelativeError = std::sqrt(relativeVariance);
+    if(relativeVariance > 0. && fFOMCPUTime > 0.)
+      fFigureOfMerit = 1. / (relativeVariance * fFOMCPUTime);
   }
 }
 
-void WLGDRunAction::EndOfRunAction(const G4Run* /*run*/)
+void WLGDRunAction::PrintFigureOfMerit(const G4String& when) const
+{
+  G4int n = fScoredEvents.GetValue();
+  G4cout << when << " weighted Ge-77 yield: " << fGe77Yield.GetValue() / std::max(n, 1)
+         << " per event over " << n << " events, relative error " << fRelativeError
+         << ", CPU time " << fFOMCPUTime << " s, FOM " << fFigureOfMerit << " /s"
+         << G4endl;
+}
+
+void WLGDRunAction::EndOfRunAction(const G4Run* run)
 {
   // Get analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
 
+  // CPU time of the event loop on this thread, summed over the workers by the merge
+  if(G4Threading::IsWorkerThread() || !G4Threading::IsMultithreadedApplication())
+    fCPUTime += ThreadCPUTime() - fRunCPUStart;
+
+  // Merge accumulables
+  G4AccumulableManager::Instance()->Merge();
+
+  if(IsMaster())
+  {
+    UpdateFigureOfMerit();
+    PrintFigureOfMerit("Run");
+
+    // aborted events are part of the processed ones and count for normalisation
+    G4cout << "Events processed: " << fEventCounts.Get(WLGDStackingAction::kEventsProcessed)
+           << ", aborted early: " << fEventCounts.Get(WLGDStackingAction::kEventsAborted)
+           << G4endl;
+    G4cout << "Neutrons killed by region cuts (time / energy):" << G4endl;
+    for(G4int role = 0; role < WLGDRegionInformation::kNumberOfRoles; ++role)
+    {
+      G4cout << "  " << WLGDRegionInformation::GetRoleName(role) << ": "
+             << fKilledNeutrons.Get(2 * role) << " / " << fKilledNeutrons.Get(2 * role + 1)
+             << G4endl;
+    }
+    if(fStackDecisions.Size() > 0)
+    {
+      G4cout << "Stacking decisions:" << G4endl;
+      for(G4int decision = 0; decision < WLGDStackingAction::kNumberOfDecisions;
+          ++decision)
+      {
+        G4cout << "  " << WLGDStackingAction::GetDecisionName(decision) << ":";
+        for(G4int role = 0; role < WLGDRegionInformation::kNumberOfRoles; ++role)
+          G4cout << " " << WLGDRegionInformation::GetRoleName(role) << " "
+                 << fStackDecisions.Get(decision * WLGDRegionInformation::kNumberOfRoles + role);
+        G4cout << G4endl;
+      }
+    }
+    if(fSkimCounts.Size() > 0)
+    {
+      const WLGDSkim& skim = fEventAction->GetSkim();
+      G4cout << "Skim: " << fSkimCounts.Get(1) << " of " << fSkimCounts.Get(0)
+             << " events written, passing:" << G4endl;
+      for(std::size_t i = 0; i < skim.GetNumberOfPredicates(); ++i)
+        G4cout << "  " << skim.GetPredicateName(i) << ": " << fSkimCounts.Get(2 + i)
+               << G4endl;
+    }
+    if(fWeightWindowCounts.Size() > 0)
+    {
+      const auto& windows = fDetector->GetWeightWindows();
+      G4cout << "Neutron weight windows:" << G4endl;
+      for(std::size_t window = 0; window < windows.size(); ++window)
+      {
+        G4cout << "  " << windows[window].volume << " ["
+               << G4BestUnit(windows[window].minEkin, "Energy") << ", "
+               << G4BestUnit(windows[window].maxEkin, "Energy") << "):";
+        for(G4int which = 0; which < WLGDBiasWeightWindow::kNumberOfWindowCounts; ++which)
+          G4cout << " " << WLGDBiasWeightWindow::GetCountName(which) << " "
+                 << fWeightWindowCounts.Get(window * WLGDBiasWeightWindow::kNumberOfWindowCounts
+                                            + which);
+        G4cout << G4endl;
+      }
+    }
+    if(fImportanceCounts.Size() > 0)
+    {
+      G4cout << "Neutron importance splitting:";
+      for(G4int which = 0; which < WLGDBiasImportanceSplitting::kNumberOfSplitCounts;
+          ++which)
+        G4cout << " " << WLGDBiasImportanceSplitting::GetCountName(which) << " "
+               << fImportanceCounts.Get(which);
+      G4cout << G4endl;
+    }
+    if(fForcedCaptureCounts.Size() > 0)
+    {
+      G4double captures = fForcedCaptureCounts.Get(WLGDBiasForcedCapture::kCaptures);
+      G4cout << "Forced neutron capture: clones "
+             << fForcedCaptureCounts.Get(WLGDBiasForcedCapture::kClones) << " captures "
+             << captures << " mean capture weight "
+             << fForcedCaptureCounts.Get(WLGDBiasForcedCapture::kCaptureWeight) /
+                  std::max(captures, 1.)
+             << G4endl;
+    }
+    if(fImplicitCaptureCounts.Size() > 0)
+      G4cout << "Implicit neutron capture roulette: killed "
+             << fImplicitCaptureCounts.Get(WLGDBiasImplicitCapture::kRouletteKilled)
+             << " survived "
+             << fImplicitCaptureCounts.Get(WLGDBiasImplicitCapture::kRouletteSurvived)
+             << G4endl;
+  }
+
   G4cout << "NumberOfNeutronCrossings: " << fNumberOfCrossingNeutrons << G4endl;
   G4cout << "TotalNumberOfNeutronInLAr: " << fTotalNumberOfNeutronsInLAr << G4endl;
 
-  // save ntuple
-  analysisManager->Write();
-  analysisManager->CloseFile();
-
-  // Edit: 2021/03/12 by Moritz Neuberger
-  // Adding output for number of neutrons crossing the detectors and total produced in LAr
-  if(fWriteOutGeneralNeutronInfo == 1)
+  // the queued events go to the file before it is written
+  if(fOutputWriter != nullptr)
   {
-    ofstream outputStream;
-    outputStream.open(fout2.c_str(), ios::app);
-    outputStream << fNumberOfCrossingNeutrons << "   " << fTotalNumberOfNeutronsInLAr
-                 << endl;
-    outputStream.close();
+    fOutputWriter->Drain();
+    G4cout << "Output writer thread: " << fOutputWriter->GetNumberOfRows()
+           << " events written, the event loop waited for it "
+           << fOutputWriter->GetNumberOfWaits() << " times" << G4endl;
   }
 
-  // Edit: 2021/03/12 by Moritz Neuberger
-  // Adding detail output for neutron production information
-  G4cout << "N of neutrons total: " << vector_x_dir.size() << G4endl;
-  if(fWriteOutNeutronProductionInfo == 1)
+  // neutrons of an event not ended by EndOfEventAction
+  WriteNeutronProductions();
+
+  // the neutron counts are kept per thread, the master of a MT run has none
+  if(fRunSummaryID >= 0 &&
+     (G4Threading::IsWorkerThread() || !G4Threading::IsMultithreadedApplication()))
   {
-    for(int i = 0; i < vector_x_dir.size(); i++)
-    {
-      outputStream_2 << vector_eventNumber[i] << " " << vector_x_dir[i] << " "
-                     << vector_y_dir[i] << " " << vector_z_dir[i] << " "
-                     << vector_x_mom[i] << " " << vector_y_mom[i] << " "
-                     << vector_z_mom[i] << " " << vector_energy[i] << " "
-                     << vector_parentParticleType[i] << endl;
-    }
-    outputStream_2.close();
+    analysisManager->FillNtupleIColumn(fRunSummaryID, 0, run->GetRunID());
+    analysisManager->FillNtupleIColumn(fRunSummaryID, 1, run->GetNumberOfEvent());
+    analysisManager->FillNtupleIColumn(fRunSummaryID, 2, fNumberOfCrossingNeutrons);
+    analysisManager->FillNtupleIColumn(fRunSummaryID, 3, fTotalNumberOfNeutronsInLAr);
+    analysisManager->AddNtupleRow(fRunSummaryID);
   }
+
+  // the last shard of this thread
+  if(fSharded &&
+     (G4Threading::IsWorkerThread() || !G4Threading::IsMultithreadedApplication()))
+    CloseShard();
+
+  // save ntuple
+  analysisManager->Write();
+  analysisManager->CloseFile();
+  fOutputFile.Finish(WLGDOutputFile::GetThreadFileName(fFileName, fMergeNtuples != 0));
+
+  // the workers have closed their shards before the master ends the run
+  if(fSharded && IsMaster())
+    WLGDOutputFile::WriteManifest(fout);
+
+  if(fPrimaryGenerator != nullptr)
+    WLGDCheckpoint::SaveThreadState(*fPrimaryGenerator);
 }
 
 void WLGDRunAction::SetWriteOutNeutronProductionInfo(G4int answer)
@@ -418,11 +537,68 @@ void WLGDRunAction::SetNeutronCaptureSiblings(G4int answer)
   fNeutronCaptureSiblings = answer;
 }
 
+G4bool WLGDRunAction::CheckBeforeBooking(const G4String& command) const
+{
+  if(!fEventAction->GetRecord().IsAllocated())
+    return true;
+  G4ExceptionDescription msg;
+  msg << "The event ntuple is already booked, " << command
+      << " can only be changed before the first run.";
+  G4Exception("WLGDRunAction::CheckBeforeBooking()", "MyCode0012", JustWarning, msg);
+  return false;
+}
+
+void WLGDRunAction::SetMergeNtuples(G4int answer)
+{
+  if(answer != fMergeNtuples && CheckBeforeBooking("mergeNtuples"))
+    fMergeNtuples = answer;
+}
+
+void WLGDRunAction::SetOutputQueueDepth(G4int depth)
+{
+  if(depth != fOutputQueueDepth && CheckBeforeBooking("asyncOutput"))
+    fOutputQueueDepth = depth;
+}
+
+void WLGDRunAction::PrintColumns() { fEventAction->GetRecord().Print(); }
+
 void WLGDRunAction::DefineCommands()
 {
   // Define /WLGD/generator command directory using generic messenger class
   fMessenger = new G4GenericMessenger(this, "/WLGD/runaction/", "Run Action control");
 
+  fMessenger->DeclareProperty("setFOMReportInterval", fFOMReportInterval)
+    .SetGuidance("Print the weighted Ge-77 yield, relative error and figure of merit")
+    .SetGuidance("of each thread every given number of events, 0 = end of run only.")
+    .SetGuidance("A thread uses its own CPU time, the end of run the sum over them.")
+    .SetParameterName("events", false)
+    .SetRange("events >= 0")
+    .SetDefaultValue("0");
+
+  fMessenger->DeclareMethod("printColumns", &WLGDRunAction::PrintColumns)
+    .SetGuidance("List the columns of the event ntuple with their type, unit and")
+    .SetGuidance("switch, marking the ones booked on this thread (+).")
+    .SetGuidance("The columns are booked at the first run, the switches of the")
+    .SetGuidance("optional ones have to be set before it.");
+
+  fMessenger->DeclareMethod("mergeNtuples", &WLGDRunAction::SetMergeNtuples)
+    .SetGuidance("Set whether the worker threads write their ntuple rows to one file")
+    .SetGuidance("0 = one file per thread (<output>_t<N>.root)")
+    .SetGuidance("1 = a single file, the rows are merged row-wise on the master")
+    .SetGuidance("Has to be set before the first run.")
+    .SetCandidates("0 1")
+    .SetDefaultValue("0");
+
+  fMessenger->DeclareMethod("asyncOutput", &WLGDRunAction::SetOutputQueueDepth)
+    .SetGuidance("Hand the event ntuple rows of each worker thread to a writer thread")
+    .SetGuidance("which serialises and compresses them, with room for the given number")
+    .SetGuidance("of events; the event loop waits when they are all queued.")
+    .SetGuidance("0 = rows are written by the worker thread itself")
+    .SetGuidance("Has to be set before the first run.")
+    .SetParameterName("events", false)
+    .SetRange("events >= 0")
+    .SetDefaultValue("0");
+
   fMessenger
     ->DeclareMethod("WriteOutNeutronProductionInfo",
                     &WLGDRunAction::SetWriteOutNeutronProductionInfo)
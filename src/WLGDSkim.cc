@@ -0,0 +1,138 @@
+#include "WLGDSkim.hh"
+
+#include <sstream>
+
+namespace
+{
+  const char* quantityNames[WLGDSkim::kNumberOfQuantities] = {
+    "Hits",
+    "NGe77",
+    "Multiplicity_prompt",
+    "Multiplicity_delayed",
+    "Multiplicity_delayed_long",
+    "GeEnergy_prompt",
+    "GeEnergy_delayed",
+    "LArEnergy_prompt",
+    "LArEnergy_delayed",
+    "WaterEnergy_prompt",
+    "WaterEnergy_delayed",
+    "MuonVeto",
+    "Neutrons"
+  };
+  const char* comparisonNames[] = { ">", ">=", "<", "<=", "==", "!=" };
+}  // namespace
+
+WLGDSkim::WLGDSkim() { DefineCommands(); }
+
+WLGDSkim::~WLGDSkim() { delete fMessenger; }
+
+const char* WLGDSkim::GetQuantityName(G4int quantity) { return quantityNames[quantity]; }
+
+G4bool WLGDSkim::Evaluate(const Values& values, std::vector<G4bool>& passed) const
+{
+  passed.assign(fPredicates.size(), false);
+  G4bool any = false;
+  G4bool all = true;
+  for(std::size_t i = 0; i < fPredicates.size(); ++i)
+  {
+    const Predicate& predicate = fPredicates[i];
+    G4double         x         = values[predicate.quantity];
+    switch(predicate.comparison)
+    {
+      case kGreater:
+        passed[i] = x > predicate.value;
+        break;
+      case kGreaterEqual:
+        passed[i] = x >= predicate.value;
+        break;
+      case kLess:
+        passed[i] = x < predicate.value;
+        break;
+      case kLessEqual:
+        passed[i] = x <= predicate.value;
+        break;
+      case kEqual:
+        passed[i] = x == predicate.value;
+        break;
+      case kNotEqual:
+        passed[i] = x != predicate.value;
+        break;
+    }
+    any = any || passed[i];
+    all = all && passed[i];
+  }
+  return fPredicates.empty() || ((fMode == "any") ? any : all);
+}
+
+void WLGDSkim::AddPredicate(Condition condition)
+{
+  const G4String& quantity   = condition.quantity;
+  const G4String& comparison = condition.comparison;
+  G4double        value      = condition.value;
+
+  Predicate predicate;
+  predicate.quantity = kNumberOfQuantities;
+  for(G4int i = 0; i < kNumberOfQuantities; ++i)
+  {
+    if(quantity == quantityNames[i])
+      predicate.quantity = (Quantity) i;
+  }
+  G4int nComparisons = sizeof(comparisonNames) / sizeof(comparisonNames[0]);
+  G4int found        = -1;
+  for(G4int i = 0; i < nComparisons; ++i)
+  {
+    if(comparison == comparisonNames[i])
+      found = i;
+  }
+
+  if(predicate.quantity == kNumberOfQuantities || found < 0)
+  {
+    G4ExceptionDescription msg;
+    msg << "Unknown skim condition `" << quantity << " " << comparison << " " << value
+        << "', see /WLGD/skim/list for the quantities.";
+    G4Exception("WLGDSkim::AddPredicate()", "MyCode0014", JustWarning, msg);
+    return;
+  }
+  predicate.comparison = (Comparison) found;
+  predicate.value      = value;
+  std::ostringstream name;
+  name << quantity << " " << comparison << " " << value;
+  predicate.name = name.str();
+  fPredicates.push_back(predicate);
+}
+
+void WLGDSkim::List()
+{
+  G4cout << "Skim quantities (energies in keV):";
+  for(const char* name : quantityNames)
+    G4cout << " " << name;
+  G4cout << G4endl << "Skim conditions, an event is written if " << fMode
+         << " of them pass:" << G4endl;
+  for(const auto& predicate : fPredicates)
+    G4cout << "  " << predicate.name << G4endl;
+}
+
+void WLGDSkim::DefineCommands()
+{
+  fMessenger = new G4GenericMessenger(this, "/WLGD/skim/",
+                                      "Commands for selecting the events written out");
+
+  fMessenger->DeclareMethod("add", &WLGDSkim::AddPredicate)
+    .SetGuidance("Add a condition on a quantity of the event:")
+    .SetGuidance("  <quantity> <comparison> <value>")
+    .SetGuidance("with comparison one of > >= < <= == !=, e.g. LArEnergy_prompt > 100.")
+    .SetGuidance("Energies are in keV; /WLGD/skim/list shows the quantities.")
+    .SetGuidance("Applies to the events kept by /WLGD/event/saveAllEvents.");
+
+  fMessenger->DeclareMethod("clear", &WLGDSkim::ClearPredicates)
+    .SetGuidance("Remove all conditions, every event kept is written.");
+
+  fMessenger->DeclareProperty("setMode", fMode)
+    .SetGuidance("Write events passing all conditions or any of them.")
+    .SetCandidates("all any")
+    .SetDefaultValue("all");
+
+  fMessenger->DeclareMethod("list", &WLGDSkim::List)
+    .SetGuidance("List the quantities and the conditions.")
+    .SetToBeBroadcasted(false);
+}
@@ -1,6 +1,35 @@
 #include "WLGDStackingAction.hh"
+#include "WLGDEventAction.hh"
+#include "WLGDRunAction.hh"
 // #include "WLGDTrackInformation.hh"
 
+#include "G4Electron.hh"
+#include "G4EventManager.hh"
+#include "G4Gamma.hh"
+#include "G4LogicalVolume.hh"
+#include "G4MuonMinus.hh"
+#include "G4MuonPlus.hh"
+#include "G4Neutron.hh"
+#include "G4ParticleTable.hh"
+#include "G4Positron.hh"
+#include "G4Region.hh"
+#include "G4VPhysicalVolume.hh"
+#include "Randomize.hh"
+
+WLGDStackingAction::WLGDStackingAction(WLGDEventAction* event, WLGDRunAction* run)
+: fEventAction(event)
+, fRunAction(run)
+{
+  DefineCommands();
+}
+
+WLGDStackingAction::~WLGDStackingAction()
+{
+  delete fStackMessenger;
+  for(auto& policy : fPolicy)
+    delete policy.messenger;
+}
+
 G4ClassificationOfNewTrack WLGDStackingAction ::ClassifyNewTrack(const G4Track* aTrack)
 {
   G4ClassificationOfNewTrack classification = fWaiting;  // fUrgent; //
@@ -10,9 +39,190 @@ G4ClassificationOfNewTrack WLGDStackingAction ::ClassifyNewTrack(const G4Track*
   //    WLGDTrackInformation* trackInfo = new WLGDTrackInformation(aTrack);
   //    aTrack->SetUserInformation(trackInfo);  // attach own track info
   //  }
+
+  // -- primaries are never touched, they have no volume assigned yet
+  if(aTrack->GetParentID() == 0 || aTrack->GetVolume() == nullptr)
+  {
+    if(fEarlyAbort != 0)
+      ++fWaitingCandidates;
+    return classification;
+  }
+
+  const auto* information = static_cast<const WLGDRegionInformation*>(
+    aTrack->GetVolume()->GetLogicalVolume()->GetRegion()->GetUserInformation());
+  const G4int role = (information != nullptr) ? information->GetRole()
+                                              : WLGDRegionInformation::kWorld;
+
+  // -- kill or roulette low-energy e- and gamma
+  const G4ParticleDefinition* particle = aTrack->GetParticleDefinition();
+  if(particle == G4Electron::Definition() || particle == G4Gamma::Definition())
+  {
+    const RolePolicy& policy = fPolicy[role];
+    const G4double    ekin   = aTrack->GetKineticEnergy();
+    if(ekin < policy.killEnergy)
+    {
+      fRunAction->addStackDecision(kKilled, role);
+      return fKill;
+    }
+    if(ekin < policy.rouletteEnergy && policy.rouletteProbability < 1.)
+    {
+      if(G4UniformRand() >= policy.rouletteProbability)
+      {
+        fRunAction->addStackDecision(kRouletteKilled, role);
+        return fKill;
+      }
+      // weight compensation of the survivor, the stack owns the track
+      const_cast<G4Track*>(aTrack)->SetWeight(aTrack->GetWeight() /
+                                              policy.rouletteProbability);
+      fRunAction->addStackDecision(kRouletteSurvived, role);
+    }
+  }
+
+  // -- with deferred particle types, everything else is processed in the current
+  // -- stage and the deferred types wait for the next one
+  if(!fDeferredParticles.empty())
+  {
+    if(fDeferredParticles.count(particle) == 0)
+      return fUrgent;
+    fRunAction->addStackDecision(kDeferred, role);
+  }
+
+  // -- remember whether anything waiting for the next stage can still make Ge-77
+  if(fEarlyAbort != 0 && IsGe77Candidate(aTrack))
+    ++fWaitingCandidates;
+
   return classification;
 }
 
-void WLGDStackingAction::NewStage() { ; }
+// -- called when the urgent stack is empty, after G4StackManager has moved the
+// -- waiting tracks to it: these are exactly the tracks classified fWaiting
+// -- during the stage that just ended, counted in fWaitingCandidates
+void WLGDStackingAction::NewStage()
+{
+  ++fStage;
+  if(fEarlyAbort != 0 && fStage >= fAbortMinimumStage && fWaitingCandidates == 0 &&
+     fEventAction->isAllEvents() == 0 && fEventAction->GetIDListOfGe77().empty())
+  {
+    fRunAction->addEventCount(kEventsAborted);
+    G4EventManager::GetEventManager()->AbortCurrentEvent();
+    return;
+  }
+  fWaitingCandidates = 0;
+}
+
+void WLGDStackingAction::PrepareNewEvent()
+{
+  fStage             = 0;
+  fWaitingCandidates = 0;
+  fRunAction->addEventCount(kEventsProcessed);
+}
+
+G4bool WLGDStackingAction::IsGe77Candidate(const G4Track* aTrack) const
+{
+  const G4ParticleDefinition* particle = aTrack->GetParticleDefinition();
+
+  // neutrons only count close enough to the detector
+  if(particle == G4Neutron::Definition())
+    return (aTrack->GetPosition() - fAbortCentre).mag2() < fAbortRadius * fAbortRadius;
+
+  // Ge-77 itself
+  if(particle->GetAtomicNumber() == 32 && particle->GetAtomicMass() == 77)
+    return true;
+
+  // e-, e+ and gamma can only make neutrons via photo-nuclear reactions
+  if(particle == G4Electron::Definition() || particle == G4Positron::Definition() ||
+     particle == G4Gamma::Definition())
+    return aTrack->GetKineticEnergy() > fAbortEMThreshold;
 
-void WLGDStackingAction::PrepareNewEvent() { ; }
+  // other nuclei and leptons (neutrinos) do not lead to neutrons, hadrons and muons can
+  const G4String& type = particle->GetParticleType();
+  return type == "baryon" || type == "meson" || particle == G4MuonMinus::Definition() ||
+         particle == G4MuonPlus::Definition();
+}
+
+void WLGDStackingAction::DeferParticle(const G4String& name)
+{
+  const G4ParticleDefinition* particle =
+    G4ParticleTable::GetParticleTable()->FindParticle(name);
+  if(particle == nullptr)
+  {
+    G4Exception("WLGDStackingAction::DeferParticle()", "MyCode0006", JustWarning,
+                ("Unknown particle '" + name + "'").c_str());
+    return;
+  }
+  fDeferredParticles.insert(particle);
+}
+
+void WLGDStackingAction::ClearDeferredParticles() { fDeferredParticles.clear(); }
+
+const char* WLGDStackingAction::GetDecisionName(G4int decision)
+{
+  static const char* names[kNumberOfDecisions] = { "killed", "roulette killed",
+                                                   "roulette survived", "deferred" };
+  return (decision >= 0 && decision < kNumberOfDecisions) ? names[decision] : "unknown";
+}
+
+void WLGDStackingAction::DefineCommands()
+{
+  // Define stacking command directory using generic messenger class
+  fStackMessenger = new G4GenericMessenger(this, "/WLGD/stack/",
+                                           "Commands for controlling the stacking policy");
+
+  fStackMessenger->DeclareMethod("deferParticle", &WLGDStackingAction::DeferParticle)
+    .SetGuidance("Defer a particle type to the next stage, all others become urgent")
+    .SetParameterName("particle", false);
+
+  fStackMessenger
+    ->DeclareMethod("clearDeferredParticles", &WLGDStackingAction::ClearDeferredParticles)
+    .SetGuidance("Remove all deferred particle types, back to default staging");
+
+  fStackMessenger->DeclareProperty("setEarlyAbort", fEarlyAbort)
+    .SetGuidance("Abort events early when no track can lead to Ge-77 any more")
+    .SetGuidance("Only applies while /WLGD/event/saveAllEvents is 0")
+    .SetGuidance("0 = off")
+    .SetGuidance("1 = on")
+    .SetCandidates("0 1");
+
+  fStackMessenger->DeclareProperty("setAbortMinimumStage", fAbortMinimumStage)
+    .SetGuidance("First stage boundary at which an event may be aborted");
+
+  fStackMessenger->DeclarePropertyWithUnit(
+    "setAbortRadius", "m", fAbortRadius,
+    "Neutrons farther than this from the abort centre are not Ge-77 candidates");
+
+  fStackMessenger->DeclarePropertyWithUnit("setAbortCentre", "m", fAbortCentre,
+                                           "Centre for the neutron radius criterion");
+
+  fStackMessenger->DeclarePropertyWithUnit(
+    "setAbortEMThreshold", "MeV", fAbortEMThreshold,
+    "e-, e+ and gamma above this energy are kept as Ge-77 candidates");
+
+  // one directory per region role, e.g. /WLGD/stack/Rock/setKillEnergy 100 keV
+  for(G4int role = 0; role < WLGDRegionInformation::kNumberOfRoles; ++role)
+  {
+    const G4String name   = WLGDRegionInformation::GetRoleName(role);
+    RolePolicy&    policy = fPolicy[role];
+    policy.messenger      = new G4GenericMessenger(
+      &policy, "/WLGD/stack/" + name + "/",
+      "Stacking policy for e- and gamma created in the " + name + " region");
+
+    policy.messenger->DeclarePropertyWithUnit(
+      "setKillEnergy", "keV", policy.killEnergy,
+      "Kill e- and gamma created below this kinetic energy");
+
+    // -- the energy deposits in the Ge, LAr and water are summed without the track
+    // -- weight, so there is no roulette where they are read out or next to them
+    if(role == WLGDRegionInformation::kWater ||
+       role == WLGDRegionInformation::kCryostat || role == WLGDRegionInformation::kInner)
+      continue;
+
+    policy.messenger->DeclarePropertyWithUnit(
+      "setRouletteEnergy", "keV", policy.rouletteEnergy,
+      "Play Russian roulette with e- and gamma created below this kinetic energy");
+    policy.messenger
+      ->DeclareProperty("setRouletteProbability", policy.rouletteProbability,
+                        "Survival probability of the roulette, the weight is scaled by "
+                        "its inverse")
+      .SetRange("setRouletteProbability>0 && setRouletteProbability<=1");
+  }
+}
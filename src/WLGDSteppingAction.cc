@@ -5,10 +5,12 @@
 #include <iostream>
 
 using namespace std;
+#include "WLGDRegionInformation.hh"
 #include "WLGDRunAction.hh"
 #include "WLGDSteppingAction.hh"
 #include "WLGDTrackingAction.hh"
 
+#include "G4Neutron.hh"
 #include "G4SystemOfUnits.hh"
 
 #include "G4RunManager.hh"
@@ -25,6 +27,30 @@ WLGDSteppingAction::WLGDSteppingAction(WLGDEventAction* event, WLGDRunAction* ru
 
 void WLGDSteppingAction::UserSteppingAction(const G4Step* aStep)
 {
+  // -- columns of the event ntuple
+  WLGDEventRecord& record = fEventAction->GetRecord();
+
+  // -- neutron time and energy cuts of the region the step was taken in, for
+  // -- neutrons still alive: a captured one ends its step at zero energy
+  G4Track* track = aStep->GetTrack();
+  if(track->GetDefinition() == G4Neutron::Definition() &&
+     track->GetTrackStatus() == fAlive)
+  {
+    // only WLGDRegionInformation is ever attached to the regions of this application
+    const auto* information = static_cast<const WLGDRegionInformation*>(
+      aStep->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume()->GetRegion()
+        ->GetUserInformation());
+    if(information != nullptr)
+    {
+      const G4bool tooLate = track->GetGlobalTime() > information->GetNeutronTimeCut();
+      if(tooLate || track->GetKineticEnergy() < information->GetNeutronEkinCut())
+      {
+        track->SetTrackStatus(fStopAndKill);
+        fRunAction->addKilledNeutron(information->GetRole(), tooLate);
+      }
+    }
+  }
+
 #define MostOuterRadiusTracking 0
   // Edit: 2021/03/05 by Moritz Neuberger
   // Adding tracking of amount of neutrons crossing the detectors
@@ -56,7 +82,8 @@ void WLGDSteppingAction::UserSteppingAction(const G4Step* aStep)
         auto physVol1 = aStep->GetTrack()->GetVolume();
         auto physVol2 = aStep->GetTrack()->GetNextVolume();
         if(physVol2->GetName() == "WLSR_LAr_physical")
-          fEventAction->Add_Muon_WLSR_Edep(aStep->GetTotalEnergyDeposit() / eV);
+          record.Increase(WLGDEventRecord::kMuon_WLSR_Edep, 0,
+                          aStep->GetTotalEnergyDeposit() / eV);
         if((physVol1->GetName() != "WLSR_LAr_physical" && physVol2->GetName() == "WLSR_LAr_physical") || (physVol1->GetName() == "WLSR_LAr_physical" && physVol2->GetName() != "WLSR_LAr_physical"))
           fEventAction->Add_Muon_WLSR_intersect(aStep->GetPostStepPoint()->GetPosition().getX() / m,aStep->GetPostStepPoint()->GetPosition().getY() / m,aStep->GetPostStepPoint()->GetPosition().getZ() / m);
       }
@@ -133,9 +160,11 @@ void WLGDSteppingAction::UserSteppingAction(const G4Step* aStep)
              ->GetName() == "Water_log")
         {
           // if(aStep->GetPostStepPoint()->GetGlobalTime() / us < 10.)
-          fEventAction->IncreaseEdepWater_prompt(aStep->GetTotalEnergyDeposit() / eV);
+          record.Increase(WLGDEventRecord::kEdepWater_prompt, 0,
+                          aStep->GetTotalEnergyDeposit() / eV);
           // else if(aStep->GetPostStepPoint()->GetGlobalTime() / ms < 1.)
-          // fEventAction->IncreaseEdepWater_delayed(aStep->GetTotalEnergyDeposit() / eV);
+          // record.Increase(WLGDEventRecord::kEdepWater_delayed, 0,
+          //                 aStep->GetTotalEnergyDeposit() / eV);
           return;
         }
   
@@ -163,28 +192,28 @@ void WLGDSteppingAction::UserSteppingAction(const G4Step* aStep)
           whichVolume = 0;
           if(aStep->GetPostStepPoint()->GetGlobalTime() / us < 10.)
           {
-            fEventAction->IncreaseLArEnergyDeposition(aStep->GetTotalEnergyDeposit() / eV,
-                                                      whichReentranceTube);
+            record.Increase(WLGDEventRecord::kLArEnergyDeposition,
+                            whichReentranceTube, aStep->GetTotalEnergyDeposit() / eV);
           }  // prompt
           else
           {
             if(aStep->GetPostStepPoint()->GetGlobalTime() / ms < 1.)
             {
-              fEventAction->IncreaseLArEnergyDeposition_delayed(
-                aStep->GetTotalEnergyDeposit() / eV, whichReentranceTube);
+              record.Increase(WLGDEventRecord::kLArEnergyDeposition_delayed,
+                              whichReentranceTube, aStep->GetTotalEnergyDeposit() / eV);
             }  // delayed
             if(aStep->GetPostStepPoint()->GetGlobalTime() / s < 1. &&
                fRunAction->getWriteOutAdvancedMultiplicity())
             {
-              fEventAction->IncreaseLArEnergyDeposition_delayed_long(
-                aStep->GetTotalEnergyDeposit() / eV, whichReentranceTube);
+              record.Increase(WLGDEventRecord::kLArEnergyDeposition_delayed_long,
+                              whichReentranceTube, aStep->GetTotalEnergyDeposit() / eV);
             }  // long delayed
           }
           if(aStep->GetPostStepPoint()->GetGlobalTime() / s > 1. &&
              fRunAction->getWriteOutAdvancedMultiplicity())
           {
-            fEventAction->IncreaseLArEnergyDeposition_after_delayed(
-              aStep->GetTotalEnergyDeposit() / eV, whichReentranceTube);
+            record.Increase(WLGDEventRecord::kLArEnergyDeposition_after_delayed,
+                            whichReentranceTube, aStep->GetTotalEnergyDeposit() / eV);
           }  // after delayed
         }
 
@@ -282,8 +311,8 @@ void WLGDSteppingAction::UserSteppingAction(const G4Step* aStep)
           if(aStep->GetPostStepPoint()->GetGlobalTime() / s > 1. &&
              fRunAction->getWriteOutAdvancedMultiplicity())
           {
-            fEventAction->IncreaseGeEnergyDeposition_after_delayed(
-              aStep->GetTotalEnergyDeposit() / eV, whichReentranceTube);
+            record.Increase(WLGDEventRecord::kGeEnergyDeposition_after_delayed,
+                            whichReentranceTube, aStep->GetTotalEnergyDeposit() / eV);
           }  // after delayed
         }
 
@@ -296,20 +325,22 @@ void WLGDSteppingAction::UserSteppingAction(const G4Step* aStep)
           {
             
 
-            fEventAction->AddGe77mGammaEmission_timing(
-              aStep->GetPostStepPoint()->GetGlobalTime() / s);
-            fEventAction->AddGe77mGammaEmission_x(
-              aStep->GetPostStepPoint()->GetGlobalTime() / m);
-            fEventAction->AddGe77mGammaEmission_y(
-              aStep->GetPostStepPoint()->GetGlobalTime() / m);
-            fEventAction->AddGe77mGammaEmission_z(
-              aStep->GetPostStepPoint()->GetGlobalTime() / m);
-            fEventAction->AddGe77mGammaEmission_edep(aStep->GetTotalEnergyDeposit() / eV);
-            fEventAction->AddGe77mGammaEmission_id(aStep->GetTrack()->GetTrackID());
-            fEventAction->AddGe77mGammaEmission_type(
-              aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding());
-            fEventAction->AddGe77mGammaEmission_whichGe77(
-              aStep->GetTrack()->GetParentID());
+            record.Add(WLGDEventRecord::kGe77mGammaEmission_timing,
+                       aStep->GetPostStepPoint()->GetGlobalTime() / s);
+            record.Add(WLGDEventRecord::kGe77mGammaEmission_x,
+                       aStep->GetPostStepPoint()->GetGlobalTime() / m);
+            record.Add(WLGDEventRecord::kGe77mGammaEmission_y,
+                       aStep->GetPostStepPoint()->GetGlobalTime() / m);
+            record.Add(WLGDEventRecord::kGe77mGammaEmission_z,
+                       aStep->GetPostStepPoint()->GetGlobalTime() / m);
+            record.Add(WLGDEventRecord::kGe77mGammaEmission_edep,
+                       aStep->GetTotalEnergyDeposit() / eV);
+            record.Add(WLGDEventRecord::kGe77mGammaEmission_id,
+                       aStep->GetTrack()->GetTrackID());
+            record.Add(WLGDEventRecord::kGe77mGammaEmission_type,
+                       aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding());
+            record.Add(WLGDEventRecord::kGe77mGammaEmission_whichGe77,
+                       aStep->GetTrack()->GetParentID());
             int whichVolume = -3;
             if(aStep->GetPostStepPoint()
                  ->GetTouchable()
@@ -330,24 +361,26 @@ void WLGDSteppingAction::UserSteppingAction(const G4Step* aStep)
                  ->GetName() == "Ge_log")
               whichVolume =
                 detector_number;
-            fEventAction->AddGe77mGammaEmission_whichVolume(whichVolume);
+            record.Add(WLGDEventRecord::kGe77mGammaEmission_whichVolume, whichVolume);
           }
 
           if(fEventAction->GetIDListOfGe77SiblingParticles().count(
                aStep->GetTrack()->GetParentID()))
           {
-            fEventAction->AddGe77Siblings_timing(
-              aStep->GetPostStepPoint()->GetGlobalTime() / s);
-            fEventAction->AddGe77Siblings_x(
-              aStep->GetPostStepPoint()->GetPosition().getX() / m);
-            fEventAction->AddGe77Siblings_y(
-              aStep->GetPostStepPoint()->GetPosition().getY() / m);
-            fEventAction->AddGe77Siblings_z(
-              aStep->GetPostStepPoint()->GetPosition().getZ() / m);
-            fEventAction->AddGe77Siblings_edep(aStep->GetTotalEnergyDeposit() / eV);
-            fEventAction->AddGe77Siblings_id(aStep->GetTrack()->GetTrackID());
-            fEventAction->AddGe77Siblings_type(
-              aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding());
+            record.Add(WLGDEventRecord::kGe77Siblings_timing,
+                       aStep->GetPostStepPoint()->GetGlobalTime() / s);
+            record.Add(WLGDEventRecord::kGe77Siblings_x,
+                       aStep->GetPostStepPoint()->GetPosition().getX() / m);
+            record.Add(WLGDEventRecord::kGe77Siblings_y,
+                       aStep->GetPostStepPoint()->GetPosition().getY() / m);
+            record.Add(WLGDEventRecord::kGe77Siblings_z,
+                       aStep->GetPostStepPoint()->GetPosition().getZ() / m);
+            record.Add(WLGDEventRecord::kGe77Siblings_edep,
+                       aStep->GetTotalEnergyDeposit() / eV);
+            record.Add(WLGDEventRecord::kGe77Siblings_id,
+                       aStep->GetTrack()->GetTrackID());
+            record.Add(WLGDEventRecord::kGe77Siblings_type,
+                       aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding());
             int whichVolume = -3;
             if(aStep->GetPostStepPoint()
                  ->GetTouchable()
@@ -368,7 +401,7 @@ void WLGDSteppingAction::UserSteppingAction(const G4Step* aStep)
                  ->GetName() == "Ge_log")
               whichVolume =
                 detector_number;
-            fEventAction->AddGe77Siblings_whichVolume(whichVolume);
+            record.Add(WLGDEventRecord::kGe77Siblings_whichVolume, whichVolume);
           }
         }  // individual deposition of sibling or secundary Ge77 interactions
 
@@ -382,18 +415,19 @@ void WLGDSteppingAction::UserSteppingAction(const G4Step* aStep)
             // aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding() << " "  <<
             // aStep->GetTrack()->GetParentID() << G4endl << "
             // ______________________________________________ " << G4endl;
-            fEventAction->AddGdSiblings_timing(
-              aStep->GetPostStepPoint()->GetGlobalTime() / s);
-            fEventAction->AddGdSiblings_x(
-              aStep->GetPostStepPoint()->GetPosition().getX() / m);
-            fEventAction->AddGdSiblings_y(
-              aStep->GetPostStepPoint()->GetPosition().getY() / m);
-            fEventAction->AddGdSiblings_z(
-              aStep->GetPostStepPoint()->GetPosition().getZ() / m);
-            fEventAction->AddGdSiblings_edep(aStep->GetTotalEnergyDeposit() / eV);
-            fEventAction->AddGdSiblings_id(aStep->GetTrack()->GetTrackID());
-            fEventAction->AddGdSiblings_type(
-              aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding());
+            record.Add(WLGDEventRecord::kGdSiblings_timing,
+                       aStep->GetPostStepPoint()->GetGlobalTime() / s);
+            record.Add(WLGDEventRecord::kGdSiblings_x,
+                       aStep->GetPostStepPoint()->GetPosition().getX() / m);
+            record.Add(WLGDEventRecord::kGdSiblings_y,
+                       aStep->GetPostStepPoint()->GetPosition().getY() / m);
+            record.Add(WLGDEventRecord::kGdSiblings_z,
+                       aStep->GetPostStepPoint()->GetPosition().getZ() / m);
+            record.Add(WLGDEventRecord::kGdSiblings_edep,
+                       aStep->GetTotalEnergyDeposit() / eV);
+            record.Add(WLGDEventRecord::kGdSiblings_id, aStep->GetTrack()->GetTrackID());
+            record.Add(WLGDEventRecord::kGdSiblings_type,
+                       aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding());
             int whichVolume = -4;
             if(aStep->GetPostStepPoint()
                  ->GetTouchable()
@@ -420,7 +454,7 @@ void WLGDSteppingAction::UserSteppingAction(const G4Step* aStep)
                  ->GetName() == "Ge_log")
               whichVolume =
                 detector_number;
-            fEventAction->AddGdSiblings_whichVolume(whichVolume);
+            record.Add(WLGDEventRecord::kGdSiblings_whichVolume, whichVolume);
           }
         }  // individual Gd interactions
 
@@ -466,18 +500,20 @@ void WLGDSteppingAction::UserSteppingAction(const G4Step* aStep)
           return;
         // all individual interactions
         {
-          fEventAction->AddIndividualEnergyDeposition_Timing(
-            aStep->GetPostStepPoint()->GetGlobalTime() / (1000 * ns));
-          fEventAction->AddIndividualEnergyDeposition_Energy(
-            aStep->GetTotalEnergyDeposit() / eV);
-          fEventAction->AddIndividualEnergyDeposition_ReentranceTube(whichReentranceTube);
-          fEventAction->AddIndividualEnergyDeposition_Position_x(tmp_x / m);
-          fEventAction->AddIndividualEnergyDeposition_Position_y(tmp_y / m);
-          fEventAction->AddIndividualEnergyDeposition_Position_z(tmp_z / m);
-          fEventAction->AddIndividualEnergyDeposition_LArOrGe(whichVolume);
-          fEventAction->AddIndividualEnergyDeposition_ID(aStep->GetTrack()->GetTrackID());
-          fEventAction->AddIndividualEnergyDeposition_Type(
-            aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding());
+          record.Add(WLGDEventRecord::kIndividualEnergyDeposition_Timing,
+                     aStep->GetPostStepPoint()->GetGlobalTime() / (1000 * ns));
+          record.Add(WLGDEventRecord::kIndividualEnergyDeposition_Energy,
+                     aStep->GetTotalEnergyDeposit() / eV);
+          record.Add(WLGDEventRecord::kIndividualEnergyDeposition_ReentranceTube,
+                     whichReentranceTube);
+          record.Add(WLGDEventRecord::kIndividualEnergyDeposition_Position_x, tmp_x / m);
+          record.Add(WLGDEventRecord::kIndividualEnergyDeposition_Position_y, tmp_y / m);
+          record.Add(WLGDEventRecord::kIndividualEnergyDeposition_Position_z, tmp_z / m);
+          record.Add(WLGDEventRecord::kIndividualEnergyDeposition_LArOrGe, whichVolume);
+          record.Add(WLGDEventRecord::kIndividualEnergyDeposition_ID,
+                     aStep->GetTrack()->GetTrackID());
+          record.Add(WLGDEventRecord::kIndividualEnergyDeposition_Type,
+                     aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding());
           int tmp = -1;
           if(aStep->GetPostStepPoint()
                ->GetTouchable()
@@ -485,7 +521,7 @@ void WLGDSteppingAction::UserSteppingAction(const G4Step* aStep)
                ->GetLogicalVolume()
                ->GetName() == "Layer_log")
             tmp = detector_number;
-          fEventAction->AddIndividualEnergyDeposition_DetectorNumber(tmp);
+          record.Add(WLGDEventRecord::kIndividualEnergyDeposition_DetectorNumber, tmp);
         }
 
       }
@@ -2,24 +2,40 @@
 // #include "WLGDTrackInformation.hh"
 #include "WLGDTrajectory.hh"
 
+#include "G4BiasingProcessInterface.hh"
+#include "G4Gamma.hh"
+#include "G4Neutron.hh"
+#include "G4ProcessManager.hh"
 #include "G4RunManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4Track.hh"
 #include "G4TrackingManager.hh"
 #include "G4EventManager.hh"
 #include "G4UnitsTable.hh"
+#include <cmath>
 #include <map>
 
 WLGDTrackingAction::WLGDTrackingAction() = default;
 
 void WLGDTrackingAction::PreUserTrackingAction(const G4Track* aTrack)
 {
+  // -- columns of the event ntuple
+  WLGDEventRecord& record = fEventAction->GetRecord();
+
   // Create trajectory for track if requested
   if(fpTrackingManager->GetStoreTrajectory() > 0)
   {
     fpTrackingManager->SetTrajectory(new WLGDTrajectory(aTrack));
   }
 
+  // record provenance of the track for the neutron production readout
+  if(fRunAction->getWriteOutNeutronProductionInfo() == 1)
+  {
+    fEventAction->AddTrackProvenance(
+      aTrack->GetTrackID(), aTrack->GetParentID(),
+      aTrack->GetParticleDefinition()->GetPDGEncoding(), aTrack->GetCreatorProcess());
+  }
+
   // add Ge77 events to ListOfGe77
   if(aTrack->GetParticleDefinition()->GetAtomicMass() == 77 &&
      aTrack->GetParticleDefinition()->GetPDGCharge() == 32)
@@ -63,46 +79,19 @@ void WLGDTrackingAction::PreUserTrackingAction(const G4Track* aTrack)
     // if all neutron info is readout, sent to output
     if(fRunAction->getWriteOutAllNeutronInfoRoot() == 1)
     {
-      fEventAction->AddNeutronxLoc(tmp_neutronXpos);
-      fEventAction->AddNeutronyLoc(tmp_neutronYpos);
-      fEventAction->AddNeutronzLoc(tmp_neutronZpos);
-      fEventAction->AddNeutronxMom(tmp_neutronXmom);
-      fEventAction->AddNeutronyMom(tmp_neutronYmom);
-      fEventAction->AddNeutronzMom(tmp_neutronZmom);
-      fEventAction->AddNeutronTime(tmp_neutronTime);
-      fEventAction->AddNeutronEkin(aTrack->GetKineticEnergy() / eV);
-      fEventAction->AddNeutronID(aTrack->GetTrackID());
-      fEventAction->AddNeutronEventID(G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID());
-      G4String volumeName = aTrack->GetVolume()
-                                        ->GetLogicalVolume()
-                                        ->GetName();
-      G4int whichVolume = -9999;
-
-      if(volumeName == "Ge_log")
-          whichVolume = 1;
-      if(volumeName == "ULar_log")
-          whichVolume = 0;
-      if(volumeName == "Copper_log")
-          whichVolume = -1;
-      if(volumeName == "BoratedPET_Logical")
-          whichVolume = -2;
-      if(volumeName == "BoratedPET_Logical_Lid")
-          whichVolume = -3;
-      if(volumeName == "Lar_log")
-          whichVolume = -4;
-      if(volumeName == "Cinn_log")
-          whichVolume = -5;
-      if(volumeName == "Cvac_log")
-          whichVolume = -6;
-     if(volumeName == "Cout_log")
-          whichVolume = -7;
-     if(volumeName == "Lid_log")
-          whichVolume = -8;
-     if(volumeName == "Bot_log")
-          whichVolume = -9;
-     if(volumeName == "Water_log")
-          whichVolume = -10;    
-     fEventAction->AddNeutronVolume(whichVolume);
+      record.Add(WLGDEventRecord::kNeutronxLoc, tmp_neutronXpos);
+      record.Add(WLGDEventRecord::kNeutronyLoc, tmp_neutronYpos);
+      record.Add(WLGDEventRecord::kNeutronzLoc, tmp_neutronZpos);
+      record.Add(WLGDEventRecord::kNeutronxMom, tmp_neutronXmom);
+      record.Add(WLGDEventRecord::kNeutronyMom, tmp_neutronYmom);
+      record.Add(WLGDEventRecord::kNeutronzMom, tmp_neutronZmom);
+      record.Add(WLGDEventRecord::kNeutronTime, tmp_neutronTime);
+      record.Add(WLGDEventRecord::kNeutronEkin, aTrack->GetKineticEnergy() / eV);
+      record.Add(WLGDEventRecord::kNeutronID, aTrack->GetTrackID());
+      record.Add(WLGDEventRecord::kNeutronEventID,
+                 G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID());
+      record.Add(WLGDEventRecord::kNeutronVolume,
+                 VolumeIndex(aTrack->GetVolume()->GetLogicalVolume()));
     }
 
     // initial value for furthest position of neutron away from center (for testing, can
@@ -110,27 +99,29 @@ void WLGDTrackingAction::PreUserTrackingAction(const G4Track* aTrack)
     fEventAction->SetMostOuterRadius(
       sqrt(tmp_neutronXpos * tmp_neutronXpos + tmp_neutronYpos * tmp_neutronYpos));
 
-    // increase number of neutrons produced
+    // increase number of neutrons produced, always for the skim
+    fEventAction->AddNeutron();
     if(fRunAction->getWriteOutGeneralNeutronInfo() == 1)
-      fEventAction->IncreaseByOne_NeutronInEvent();
+      record.Increase(WLGDEventRecord::kNeutronsInEvent, 0, 1);
 
     // if production of neutrons in Ge76 nC is recorded, channel to output
     if(fRunAction->getWriteOutNeutronProductionInfo() == 1)
     {
       fRunAction->increaseTotalNumberOfNeutronsInLAr();
-      fRunAction->addEventNumber(
-        G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID());
-      fRunAction->addCoordinatsToFile(tmp_neutronXpos, tmp_neutronYpos, tmp_neutronZpos);
-      fRunAction->addMomentumToFile(tmp_neutronXmom, tmp_neutronYmom, tmp_neutronZmom);
-      fRunAction->addEnergyToFile(aTrack->GetKineticEnergy() / eV);
-      fRunAction->addParentParticleType(
-        fEventAction->neutronProducerMap.find(aTrack->GetParentID())->second);
+      fRunAction->addNeutronProduction(
+        G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID(),
+        G4ThreeVector(tmp_neutronXpos, tmp_neutronYpos, tmp_neutronZpos),
+        G4ThreeVector(tmp_neutronXmom, tmp_neutronYmom, tmp_neutronZmom),
+        aTrack->GetKineticEnergy() / eV, fEventAction->GetTrackPDG(aTrack->GetParentID()));
     }
   }
 }
 
 void WLGDTrackingAction::PostUserTrackingAction(const G4Track* aTrack)
 {
+  // -- columns of the event ntuple
+  WLGDEventRecord& record = fEventAction->GetRecord();
+
   // for tracking of particles creatd in Gd interactions
   if(fRunAction->getIndividualGdDepositionInfo())
   {
@@ -155,167 +146,183 @@ void WLGDTrackingAction::PostUserTrackingAction(const G4Track* aTrack)
   // write to output muon information
   if(aTrack->GetTrackID() == 1)
   {
-    fEventAction->AddMuonxLoc(tmp_MuonXpos);
-    fEventAction->AddMuonyLoc(tmp_MuonYpos);
-    fEventAction->AddMuonzLoc(tmp_MuonZpos);
-    fEventAction->AddMuonxMom(tmp_MuonXmom);
-    fEventAction->AddMuonyMom(tmp_MuonYmom);
-    fEventAction->AddMuonzMom(tmp_MuonZmom);
-    fEventAction->AddMuonEnergy(tmp_MuonEnergy);
+    record.Add(WLGDEventRecord::kMuonxLoc, tmp_MuonXpos);
+    record.Add(WLGDEventRecord::kMuonyLoc, tmp_MuonYpos);
+    record.Add(WLGDEventRecord::kMuonzLoc, tmp_MuonZpos);
+    record.Add(WLGDEventRecord::kMuonxMom, tmp_MuonXmom);
+    record.Add(WLGDEventRecord::kMuonyMom, tmp_MuonYmom);
+    record.Add(WLGDEventRecord::kMuonzMom, tmp_MuonZmom);
+    record.Add(WLGDEventRecord::kMuonEnergy, tmp_MuonEnergy);
   }
 
-  if(fRunAction->getWriteOutNeutronProductionInfo() == 1)
-  {
-    G4TrackVector* secondaries = fpTrackingManager->GimmeSecondaries();
-    if(secondaries != nullptr)
-    {
-      size_t nSeco = secondaries->size();
-      if(nSeco > 0)
-      {
-        for(size_t i = 0; i < nSeco; i++)
-        {
-          // Edit: 2021/03/30 by Moritz Neuberger
-          // Adding map of parent particles that create neutrons used above
-          if((*secondaries)[i]->GetParticleDefinition()->GetParticleName() == "neutron")
-          {
-            fEventAction->neutronProducerMap.insert(
-              std::make_pair((int) aTrack->GetTrackID(),
-                             (int) aTrack->GetParticleDefinition()->GetPDGEncoding()));
-          }
-        }
-      }
-    }
-  }
+  if(!fProcessesResolved)
+    ResolveProcesses();
+
+  // -- classify the secondaries of the last step in a single pass
+  const G4Step*                      step        = aTrack->GetStep();
+  const std::vector<const G4Track*>* secondaries = step->GetSecondaryInCurrentStep();
+  const G4StepPoint*                 postStep    = step->GetPostStepPoint();
+  const G4VProcess*                  process     = postStep->GetProcessDefinedStep();
+  const G4int                        pdg = aTrack->GetParticleDefinition()->GetPDGEncoding();
 
   // For Ge77m IC readout
-  if(aTrack->GetParticleDefinition()->GetPDGEncoding() == 1000320771)
+  const G4bool isGe77m = (pdg == 1000320771);
+  if(isGe77m)
+    record.Set(WLGDEventRecord::kisMetastable, 0, 1);
+  const G4bool checkIC = isGe77m;
+
+  // Edit: 2021/03/30 by Moritz Neuberger
+  // Adding tracking of nC on different nuclei
+  const G4bool isCapture =
+    (process != nullptr && process == fCaptureProcess && pdg == 2112);
+  const G4bool allProductions = fEventAction->isAllProductions();
+
+  if(secondaries == nullptr || (!checkIC && !isCapture && !allProductions))
+    return;
+
+  const G4double time    = postStep->GetGlobalTime() / s;
+  const G4double x       = postStep->GetPosition().getX() / m;
+  const G4double y       = postStep->GetPosition().getY() / m;
+  const G4double z       = postStep->GetPosition().getZ() / m;
+  G4int          eventID = 0;
+  G4int          volume  = -9999;
+  if(isCapture)
   {
-    fEventAction->SetisMetastable(1);
-    int NumberOfSecundaries = aTrack->GetStep()->GetSecondaryInCurrentStep()->size();
-    for(int i = 0; i < NumberOfSecundaries; i++)
-    {
-      if(aTrack->GetStep()
-             ->GetSecondaryInCurrentStep()
-             ->at(i)
-             ->GetParticleDefinition()
-             ->GetParticleName() == "gamma" &&
-         abs(aTrack->GetStep()->GetSecondaryInCurrentStep()->at(i)->GetTotalEnergy() /
-               eV -
-             160e3) < 1e3)
-        fEventAction->SetisIC(1);
-    }
+    eventID = G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
+    volume  = VolumeIndex(aTrack->GetVolume()->GetLogicalVolume());
   }
 
-  // Edit: 2021/03/30 by Moritz Neuberger
+  // -- run-level histograms, filled once per capture from its residual nucleus
+  const WLGDHistograms& histograms = fRunAction->GetHistograms();
+  const G4bool          fillCapture =
+    isCapture && (histograms.HasHistograms(WLGDHistograms::kCapture) ||
+                  histograms.HasHistograms(WLGDHistograms::kGe77));
+  G4double point[WLGDHistograms::kNumberOfPointQuantities];
+  if(fillCapture)
+  {
+    point[WLGDHistograms::kX]    = x;
+    point[WLGDHistograms::kY]    = y;
+    point[WLGDHistograms::kZ]    = z;
+    point[WLGDHistograms::kR]    = std::sqrt(x * x + y * y);
+    point[WLGDHistograms::kTime] = postStep->GetGlobalTime() / us;
+    point[WLGDHistograms::kEkin] = step->GetPreStepPoint()->GetKineticEnergy() / eV;
+  }
 
-  // Adding tracking of nC on different nuclei
-  if(aTrack->GetParticleDefinition()->GetParticleName() == "neutron")
+  for(const G4Track* secondary : *secondaries)
   {
-    if(aTrack->GetStep()->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName() ==
-       "biasWrapper(nCapture)")  // altered name necessary due to biasing
+    const G4ParticleDefinition* def = secondary->GetParticleDefinition();
+    const G4int                 A   = def->GetAtomicMass();
+    const G4int                 ZC  = (G4int) def->GetPDGCharge();
+
+    if(checkIC && def == G4Gamma::Definition() &&
+       std::abs(secondary->GetTotalEnergy() / eV - 160e3) < 1e3)
+      record.Set(WLGDEventRecord::kisIC, 0, 1);
+
+    if(isCapture)
     {
-      int NumberOfSecundaries = aTrack->GetStep()->GetSecondaryInCurrentStep()->size();
-      for(int i = 0; i < NumberOfSecundaries; i++)
+      if(A == 77 && ZC == 32)
+        record.Add(WLGDEventRecord::kEkin,
+                   step->GetPreStepPoint()->GetKineticEnergy() / eV);
+
+      record.Add(WLGDEventRecord::knCOther_timing, time);
+      record.Add(WLGDEventRecord::knCOther_x, x);
+      record.Add(WLGDEventRecord::knCOther_y, y);
+      record.Add(WLGDEventRecord::knCOther_z, z);
+      record.Add(WLGDEventRecord::knCOther_A, A);
+      record.Add(WLGDEventRecord::knCOther_ZC, ZC);
+      record.Add(WLGDEventRecord::knCOther_ID, aTrack->GetTrackID());
+      record.Add(WLGDEventRecord::knCOther_EventID, eventID);
+      record.Add(WLGDEventRecord::knCOther_Volume, volume);
+
+      if(fillCapture && A > 1)
       {
-        if(aTrack->GetStep()
-               ->GetSecondaryInCurrentStep()
-               ->at(i)
-               ->GetParticleDefinition()
-               ->GetAtomicMass() == 77 &&
-           aTrack->GetStep()
-               ->GetSecondaryInCurrentStep()
-               ->at(i)
-               ->GetParticleDefinition()
-               ->GetPDGCharge() == 32)
-        {
-          fEventAction->AddEkin(aTrack->GetStep()->GetPreStepPoint()->GetKineticEnergy() / eV);
-        }
-        
-        fEventAction->AddnCOther_timing(
-          aTrack->GetStep()->GetPostStepPoint()->GetGlobalTime() / s);
-        fEventAction->AddnCOther_x(
-          aTrack->GetStep()->GetPostStepPoint()->GetPosition().getX() / m);
-        fEventAction->AddnCOther_y(
-          aTrack->GetStep()->GetPostStepPoint()->GetPosition().getY() / m);
-        fEventAction->AddnCOther_z(
-          aTrack->GetStep()->GetPostStepPoint()->GetPosition().getZ() / m);
-        fEventAction->AddnCOther_A(aTrack->GetStep()
-                                     ->GetSecondaryInCurrentStep()
-                                     ->at(i)
-                                     ->GetParticleDefinition()
-                                     ->GetAtomicMass());
-        fEventAction->AddnCOther_ZC(aTrack->GetStep()
-                                      ->GetSecondaryInCurrentStep()
-                                      ->at(i)
-                                      ->GetParticleDefinition()
-                                      ->GetPDGCharge());
-        // fEventAction->AddnCOther_ID(aTrack->GetParentID());
-        fEventAction->AddnCOther_ID(aTrack->GetTrackID());
-        fEventAction->AddnCOther_EventID(G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID());
-
-        G4String volumeName = aTrack->GetVolume()
-                                        ->GetLogicalVolume()
-                                        ->GetName();
-        G4int whichVolume = -9999;
-
-        if(volumeName == "Ge_log")
-              whichVolume = 1;
-        if(volumeName == "ULar_log")
-              whichVolume = 0;
-        if(volumeName == "Copper_log")
-              whichVolume = -1;
-        if(volumeName == "BoratedPET_Logical")
-              whichVolume = -2;
-        if(volumeName == "BoratedPET_Logical_Lid")
-              whichVolume = -3;
-        if(volumeName == "Lar_log")
-              whichVolume = -4;
-        if(volumeName == "Cinn_log")
-              whichVolume = -5;
-        if(volumeName == "Cvac_log")
-              whichVolume = -6;
-        if(volumeName == "Cout_log")
-              whichVolume = -7;
-        if(volumeName == "Lid_log")
-              whichVolume = -8;
-        if(volumeName == "Bot_log")
-              whichVolume = -9;
-        if(volumeName == "Water_log")
-              whichVolume = -10;    
-        fEventAction->AddnCOther_Volume(whichVolume);
+        point[WLGDHistograms::kA]  = A;
+        point[WLGDHistograms::kZC] = ZC;
+        histograms.Fill(WLGDHistograms::kCapture, point, aTrack->GetWeight());
+        if(A == 77 && ZC == 32)
+          histograms.Fill(WLGDHistograms::kGe77, point, aTrack->GetWeight());
       }
     }
-  }
-  if(fEventAction->isAllProductions()){
-    int NumberOfSecundaries = aTrack->GetStep()->GetSecondaryInCurrentStep()->size();
-    for(int i = 0; i < NumberOfSecundaries; i++)
+
+    if(allProductions && A > 0)
     {
-      if(aTrack->GetStep()
-                ->GetSecondaryInCurrentStep()
-                ->at(i)
-                ->GetParticleDefinition()
-                ->GetAtomicMass() > 0){
-                    fEventAction->Addprod_timing(
-                      aTrack->GetStep()->GetPostStepPoint()->GetGlobalTime() / s);
-                    fEventAction->Addprod_x(
-                      aTrack->GetStep()->GetPostStepPoint()->GetPosition().getX() / m);
-                    fEventAction->Addprod_y(
-                      aTrack->GetStep()->GetPostStepPoint()->GetPosition().getY() / m);
-                    fEventAction->Addprod_z(
-                      aTrack->GetStep()->GetPostStepPoint()->GetPosition().getZ() / m);
-                    fEventAction->Addprod_A(aTrack->GetStep()
-                                ->GetSecondaryInCurrentStep()
-                                ->at(i)
-                                ->GetParticleDefinition()
-                                ->GetAtomicMass());
-                    fEventAction->Addprod_ZC(aTrack->GetStep()
-                                ->GetSecondaryInCurrentStep()
-                                ->at(i)
-                                ->GetParticleDefinition()
-                                ->GetPDGCharge());
-                    fEventAction->Addprod_parentType(aTrack->GetParticleDefinition()
-                                ->GetPDGEncoding());
-                }
+      record.Add(WLGDEventRecord::kprod_timing, time);
+      record.Add(WLGDEventRecord::kprod_x, x);
+      record.Add(WLGDEventRecord::kprod_y, y);
+      record.Add(WLGDEventRecord::kprod_z, z);
+      record.Add(WLGDEventRecord::kprod_A, A);
+      record.Add(WLGDEventRecord::kprod_ZC, ZC);
+      record.Add(WLGDEventRecord::kprod_parentType, pdg);
     }
   }
 }
+
+// -- look up the processes the classifier compares against, once per thread after
+// -- the physics list is built. A process wrapped for biasing is identified by
+// -- its wrapper, since that is what defines the step.
+void WLGDTrackingAction::ResolveProcesses()
+{
+  fProcessesResolved = true;
+
+  fCaptureProcess =
+    FindProcess(G4Neutron::Definition()->GetProcessManager(), "nCapture");
+
+  if(fCaptureProcess == nullptr)
+  {
+    G4Exception("WLGDTrackingAction::ResolveProcesses()", "MyCode0003", JustWarning,
+                "No nCapture process found for neutrons, capture readout disabled");
+  }
+}
+
+const G4VProcess* WLGDTrackingAction::FindProcess(const G4ProcessManager* manager,
+                                                  const G4String&         name)
+{
+  if(manager == nullptr)
+    return nullptr;
+
+  G4ProcessVector* processes = manager->GetProcessList();
+  for(G4int i = 0; i < (G4int) processes->size(); ++i)
+  {
+    const G4VProcess* process = (*processes)[i];
+    const auto* wrapper = dynamic_cast<const G4BiasingProcessInterface*>(process);
+    const G4VProcess* physics =
+      (wrapper != nullptr && wrapper->GetWrappedProcess() != nullptr)
+        ? wrapper->GetWrappedProcess()
+        : process;
+    if(physics->GetProcessName() == name)
+      return process;
+  }
+  return nullptr;
+}
+
+// -- volume code used in the neutron and nCOther columns
+G4int WLGDTrackingAction::VolumeIndex(const G4LogicalVolume* volume)
+{
+  const G4String& volumeName = volume->GetName();
+
+  if(volumeName == "Ge_log")
+    return 1;
+  if(volumeName == "ULar_log")
+    return 0;
+  if(volumeName == "Copper_log")
+    return -1;
+  if(volumeName == "BoratedPET_Logical")
+    return -2;
+  if(volumeName == "BoratedPET_Logical_Lid")
+    return -3;
+  if(volumeName == "Lar_log")
+    return -4;
+  if(volumeName == "Cinn_log")
+    return -5;
+  if(volumeName == "Cvac_log")
+    return -6;
+  if(volumeName == "Cout_log")
+    return -7;
+  if(volumeName == "Lid_log")
+    return -8;
+  if(volumeName == "Bot_log")
+    return -9;
+  if(volumeName == "Water_log")
+    return -10;
+  return -9999;
+}
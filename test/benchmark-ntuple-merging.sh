@@ -0,0 +1,51 @@
+#!/bin/sh
+# Throughput of the per-thread and the merged ntuple output, not run by ctest.
+#
+# usage: benchmark-ntuple-merging.sh <warwick-legend> [events] [threads ...]
+#
+# Every event is saved so that the output dominates as much as it can. The
+# thread count is capped by warwick-legend to the cores of the machine, the
+# number actually used is taken from its output.
+
+app=${1:?usage: $0 <warwick-legend> [events] [threads ...]}
+events=${2:-2000}
+shift 2 2>/dev/null || shift $#
+threads=${*:-8 32 64}
+# -- the runs are made in their own directories
+app=$(cd "$(dirname "$app")" && pwd)/$(basename "$app")
+
+workdir=$(mktemp -d)
+trap 'rm -rf "$workdir"' EXIT
+
+printf "%8s %8s %8s %10s %10s %6s %8s\n" mode threads events seconds events/s files MB
+for n in $threads; do
+  for merge in 0 1; do
+    rundir="$workdir/t$n-m$merge"
+    mkdir -p "$rundir"
+    cat > "$rundir/run.mac" <<MAC
+/run/verbose 0
+/event/verbose 0
+/tracking/verbose 0
+/run/setCut 3.0 cm
+/WLGD/runaction/mergeNtuples $merge
+/WLGD/event/saveAllEvents 1
+/run/initialize
+/run/beamOn $events
+MAC
+    start=$(date +%s.%N)
+    (cd "$rundir" && "$app" -t "$n" -o bench.root -m run.mac > run.log 2>&1) || {
+      echo "run with $n threads and mergeNtuples $merge failed, see below" >&2
+      tail -20 "$rundir/run.log" >&2
+      exit 1
+    }
+    end=$(date +%s.%N)
+    used=$(sed -n 's/.*constructed in MT mode: \([0-9]*\) threads.*/\1/p' "$rundir/run.log")
+    files=$(ls "$rundir"/bench*.root | wc -l)
+    size=$(du -cm "$rundir"/bench*.root | tail -1 | cut -f1)
+    if [ "$merge" = 1 ]; then mode=merged; else mode=thread; fi
+    awk -v mode="$mode" -v n="${used:-$n}" -v events="$events" -v start="$start" \
+      -v end="$end" -v files="$files" -v size="$size" 'BEGIN {
+        printf "%8s %8s %8s %10.1f %10.2f %6s %8s\n", mode, n, events, end - start,
+          events / (end - start), files, size }'
+  done
+done
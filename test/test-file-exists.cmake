@@ -0,0 +1,29 @@
+# Usage:
+#  cmake -DTEST_FILE=/path/to/file [-DTEST_REGEX=<regex>] -P test-file-exists.cmake
+#
+# Check that an output file of a test run exists and is not empty
+# - With TEST_REGEX, the contents of a text file must also match it
+#
+
+# Input Error checking
+if(NOT TEST_FILE)
+  message(FATAL_ERROR "no TEST_FILE argument passed")
+endif()
+
+if(NOT (EXISTS ${TEST_FILE}))
+  message(FATAL_ERROR "input file '${TEST_FILE}' does not exist")
+endif()
+
+file(READ "${TEST_FILE}" TEST_FILE_START LIMIT 1 HEX)
+if(TEST_FILE_START STREQUAL "")
+  message(FATAL_ERROR "File '${TEST_FILE}' exists but is of zero length")
+endif()
+
+if(TEST_REGEX)
+  file(READ "${TEST_FILE}" TEST_FILE_CONTENTS)
+  if(NOT TEST_FILE_CONTENTS MATCHES "${TEST_REGEX}")
+    message(FATAL_ERROR "File '${TEST_FILE}' does not match '${TEST_REGEX}':\n${TEST_FILE_CONTENTS}")
+  endif()
+endif()
+
+message(STATUS "${TEST_FILE}")
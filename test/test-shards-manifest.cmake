@@ -0,0 +1,60 @@
+# Usage:
+#  cmake -DMANIFEST=/path/to/output.manifest -DRUN_EVENTS=<events of run 0>,<run 1>,...
+#        -P test-shards-manifest.cmake
+#
+# Check the shards listed in a /WLGD/output/shardEvery manifest
+# - every shard with events has an event range first <= last holding them
+# - the events of the shards of each run add up to the events of the run
+#
+
+# Input Error checking
+if(NOT MANIFEST)
+  message(FATAL_ERROR "no MANIFEST argument passed")
+endif()
+if(NOT RUN_EVENTS)
+  message(FATAL_ERROR "no RUN_EVENTS argument passed")
+endif()
+
+if(NOT (EXISTS ${MANIFEST}))
+  message(FATAL_ERROR "input file '${MANIFEST}' does not exist")
+endif()
+
+string(REPLACE "," ";" RUN_EVENTS "${RUN_EVENTS}")
+list(LENGTH RUN_EVENTS NUMBER_OF_RUNS)
+math(EXPR LAST_RUN "${NUMBER_OF_RUNS} - 1")
+foreach(RUN RANGE ${LAST_RUN})
+  set(EVENTS_OF_RUN_${RUN} 0)
+endforeach()
+
+# file run shard thread first_event last_event events
+file(STRINGS "${MANIFEST}" LINES REGEX "^[^#]")
+foreach(LINE IN LISTS LINES)
+  string(REGEX MATCH "^[^ ]+ ([0-9]+) ([0-9]+) (-?[0-9]+) (-?[0-9]+) (-?[0-9]+) ([0-9]+)$"
+         FIELDS "${LINE}")
+  if(NOT FIELDS)
+    message(FATAL_ERROR "Malformed manifest line '${LINE}'")
+  endif()
+  set(RUN ${CMAKE_MATCH_1})
+  set(FIRST ${CMAKE_MATCH_4})
+  set(LAST ${CMAKE_MATCH_5})
+  set(EVENTS ${CMAKE_MATCH_6})
+  if(RUN GREATER LAST_RUN)
+    message(FATAL_ERROR "Shard of unexpected run ${RUN}: '${LINE}'")
+  endif()
+  if(EVENTS GREATER 0)
+    math(EXPR RANGE "${LAST} - ${FIRST} + 1")
+    if(FIRST LESS 0 OR RANGE LESS EVENTS)
+      message(FATAL_ERROR "Event range does not hold the events of '${LINE}'")
+    endif()
+  endif()
+  math(EXPR EVENTS_OF_RUN_${RUN} "${EVENTS_OF_RUN_${RUN}} + ${EVENTS}")
+endforeach()
+
+foreach(RUN RANGE ${LAST_RUN})
+  list(GET RUN_EVENTS ${RUN} EXPECTED)
+  if(NOT EVENTS_OF_RUN_${RUN} EQUAL EXPECTED)
+    message(FATAL_ERROR
+      "Shards of run ${RUN} hold ${EVENTS_OF_RUN_${RUN}} events, expected ${EXPECTED}")
+  endif()
+  message(STATUS "Run ${RUN}: ${EXPECTED} events in its shards")
+endforeach()
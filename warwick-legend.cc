@@ -23,10 +23,10 @@
 #include "G4VisExecutive.hh"
 
 #include "G4GenericBiasingPhysics.hh"
-#include "G4NeutronTrackingCut.hh"
 #include "G4Threading.hh"
 #include "G4UImanager.hh"
 #include "G4RadioactiveDecayPhysics.hh"
+#include "G4StepLimiterPhysics.hh"
 #include "QGSP_BIC_HP.hh"
 #include "Shielding.hh"
 #include "QGSP_BIC.hh"
@@ -36,7 +36,9 @@
 // us
 #include "CLI11.hpp"  // c++17 safe; https://github.com/CLIUtils/CLI11
 #include "WLGDActionInitialization.hh"
+#include "WLGDCheckpoint.hh"
 #include "WLGDDetectorConstruction.hh"
+#include "WLGDPilotRun.hh"
 #include "WLGDPrimaryGeneratorAction.hh"
 
 void handler(int sig) {
@@ -61,11 +63,15 @@ int main(int argc, char** argv)
     int         nthreads = 1;
     std::string outputFileName("lg.root");
     std::string macroName;
+    std::string resumeName;
 
     app.add_option("-m,--macro", macroName, "<Geant4 macro filename> Default: None");
     app.add_option("-o,--outputFile", outputFileName,
                    "<FULL PATH ROOT FILENAME> Default: lg.root");
     app.add_option("-t, --nthreads", nthreads, "<number of threads to use> Default: 4");
+    app.add_option("--resume", resumeName,
+                   "<checkpoint filename> continue /WLGD/checkpoint/beamOn of the macro "
+                   "after the last finished run. Default: None");
 
     CLI11_PARSE(app, argc, argv);
 
@@ -105,10 +111,14 @@ int main(int argc, char** argv)
     // -- set user physics list
     auto* physicsList = new Shielding;//new  QGSP_BERT_HP;//new Shielding;
 
-    // allow for thermal neutrons to find Ge
-    auto* neutronCut  = new G4NeutronTrackingCut(1);
-    neutronCut->SetTimeLimit(2.0 * CLHEP::ms);  // 2 milli sec limit
-    physicsList->RegisterPhysics(neutronCut);   // like in Gerda paper
+    // neutron time (2 ms like in Gerda paper) and energy cuts are applied per region
+    // by WLGDSteppingAction, see /WLGD/regions/
+
+    // user limits of the regions (max time, min ekin, min range) via G4UserSpecialCuts,
+    // attached to neutral particles too so that neutrons and gammas obey them
+    auto* stepLimiterPhysics = new G4StepLimiterPhysics();
+    stepLimiterPhysics->SetApplyToAll(true);
+    physicsList->RegisterPhysics(stepLimiterPhysics);
 
     // - Setup biasing, first for neutrons, again for muons
     auto* biasingPhysics = new G4GenericBiasingPhysics();
@@ -118,6 +128,12 @@ int main(int argc, char** argv)
     pvec.push_back(pname);                     // here with single data member
     pname = "neutronInelastic";
     pvec.push_back(pname);
+    // elastic scattering and fission only for the exponential transform and
+    // /WLGD/bias/setFactor, their default factor is one
+    pname = "hadElastic";
+    pvec.push_back(pname);
+    pname = "nFission";
+    pvec.push_back(pname);
     biasingPhysics->Bias("neutron", pvec);     // bias particle and process
 
     pvec.clear();
@@ -163,6 +179,14 @@ int main(int argc, char** argv)
     auto* actions = new WLGDActionInitialization(detector, outputFileName);
     runManager->SetUserInitialization(actions);
 
+    // -- bias factor tuning by pilot runs, see /WLGD/pilot/
+    WLGDPilotRun pilot(detector);
+
+    // -- checkpointed production runs, see /WLGD/checkpoint/
+    WLGDCheckpoint checkpoint(outputFileName);
+    if(!resumeName.empty())
+      checkpoint.Resume(resumeName);
+
     // Initialize G4 kernel
     //
     // runManager->Initialize();
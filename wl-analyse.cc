@@ -0,0 +1,280 @@
+// ********************************************************************
+// warwick-legend project: summaries of the Score ntuple over many output
+// files, compiled and multithreaded with RDataFrame; the interpreted
+// analyseRootOutput.C remains for printing single events
+
+// standard
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ROOT
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RVec.hxx"
+#include "TClass.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TKey.h"
+#include "TROOT.h"
+
+// us
+#include "CLI11.hpp"  // c++17 safe; https://github.com/CLIUtils/CLI11
+
+using ROOT::VecOps::RVec;
+
+namespace
+{
+  // -- files of a /WLGD/output/shardEvery manifest, relative to its directory; a
+  // -- file listed again, as after a resumed checkpoint, is read once
+  void ReadManifest(const std::string& manifestName, std::vector<std::string>& files)
+  {
+    std::string directory;
+    auto        slash = manifestName.rfind('/');
+    if(slash != std::string::npos)
+      directory = manifestName.substr(0, slash + 1);
+
+    std::ifstream in(manifestName);
+    if(!in.good())
+      std::cerr << "Manifest " << manifestName << " can not be read" << std::endl;
+    std::string line;
+    while(std::getline(in, line))
+    {
+      std::istringstream fields(line);
+      std::string        file;
+      if(!(fields >> file) || file[0] == '#')
+        continue;
+      if(file[0] != '/')
+        file = directory + file;
+      if(std::find(files.begin(), files.end(), file) == files.end())
+        files.push_back(file);
+    }
+  }
+
+  // -- weighted Ge-77 score of an event as in WLGDRunAction: each Ge-77 nucleus
+  // -- with hits counts once, at its weight
+  double Ge77Score(const RVec<int>& hitID, const RVec<double>& weight)
+  {
+    std::vector<int> scored;
+    double           score = 0.;
+    for(std::size_t i = 0; i < hitID.size(); ++i)
+    {
+      if(std::find(scored.begin(), scored.end(), hitID[i]) != scored.end())
+        continue;
+      scored.push_back(hitID[i]);
+      score += weight[i];
+    }
+    return score;
+  }
+
+  // -- sums the /WLGD/histo histograms, e.g. the capture locations, of all files
+  void AddHistograms(TFile& file, std::map<std::string, std::unique_ptr<TH1>>& histograms)
+  {
+    for(auto* object : *file.GetListOfKeys())
+    {
+      auto* key = static_cast<TKey*>(object);
+      // -- only the last cycle of each object
+      if(file.GetKey(key->GetName()) != key)
+        continue;
+      if(!TClass::GetClass(key->GetClassName())->InheritsFrom(TH1::Class()))
+        continue;
+      auto  histogram = std::unique_ptr<TH1>(key->ReadObject<TH1>());
+      auto& sum       = histograms[key->GetName()];
+      if(sum == nullptr)
+      {
+        histogram->SetDirectory(nullptr);
+        sum = std::move(histogram);
+      }
+      else
+        sum->Add(histogram.get());
+    }
+  }
+
+  double Fraction(double part, double total) { return (total > 0.) ? part / total : 0.; }
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  // command line interface
+  CLI::App                 app{ "Summaries of warwick-legend output files" };
+  std::vector<std::string> inputFiles;
+  std::vector<std::string> manifests;
+  std::string              outputFileName("wl-analyse.root");
+  int                      nthreads = 0;
+  double                   rMax     = 10.;
+  double                   zMax     = 10.;
+
+  app.add_option("files", inputFiles, "<ROOT files>");
+  app.add_option("-l,--manifest", manifests,
+                 "<manifest of /WLGD/output/shardEvery> adds the shards it lists");
+  app.add_option("-o,--outputFile", outputFileName,
+                 "<ROOT file for the histograms> Default: wl-analyse.root");
+  app.add_option("-t,--nthreads", nthreads, "<number of threads to use> Default: all");
+  app.add_option("--rmax", rMax,
+                 "<radius range of the location histograms [m]> Default: 10");
+  app.add_option("--zmax", zMax,
+                 "<height range of the location histograms [m]> Default: 10");
+
+  CLI11_PARSE(app, argc, argv);
+
+  for(const auto& manifest : manifests)
+    ReadManifest(manifest, inputFiles);
+
+  // -- the master file of a MT run has no Score ntuple unless the rows are
+  // -- merged but holds the run histograms, and the run summary is optional
+  std::vector<std::string>                    scoreFiles;
+  std::vector<std::string>                    summaryFiles;
+  std::map<std::string, std::unique_ptr<TH1>> histograms;
+  for(const auto& name : inputFiles)
+  {
+    std::unique_ptr<TFile> file(TFile::Open(name.c_str(), "READ"));
+    if(file == nullptr || file->IsZombie())
+    {
+      std::cerr << "Skipping " << name << ": can not be opened" << std::endl;
+      continue;
+    }
+    if(file->Get("Score") != nullptr)
+      scoreFiles.push_back(name);
+    if(file->Get("RunSummary") != nullptr)
+      summaryFiles.push_back(name);
+    AddHistograms(*file, histograms);
+  }
+  if(scoreFiles.empty())
+  {
+    std::cerr << "No file with a Score ntuple given" << std::endl;
+    return 1;
+  }
+
+  if(nthreads > 0)
+    ROOT::EnableImplicitMT(nthreads);
+  else
+    ROOT::EnableImplicitMT();
+
+  // -- all results are booked first and filled in a single event loop
+  ROOT::RDataFrame frame("Score", scoreFiles);
+  auto             events =
+    frame.Define("ge77Score", Ge77Score, { "HitID", "Weight" })
+      .Define("nGe77", [](const RVec<int>& n) { return n.empty() ? 0 : n[0]; },
+              { "NGe77" })
+      .Define("multiplicity", [](const RVec<int>& m) { return ROOT::VecOps::Sum(m); },
+              { "Multiplicity_prompt" })
+      .Define("vetoed", [](const RVec<int>& v) { return !v.empty() && v[0] != 0; },
+              { "MunoVeto" })
+      .Define("ge77Score2", [](double score) { return score * score; }, { "ge77Score" });
+
+  auto nEvents   = events.Count();
+  auto nGe77     = events.Sum<int>("nGe77");
+  auto yield     = events.Sum<double>("ge77Score");
+  auto yield2    = events.Sum<double>("ge77Score2");
+  auto ge77      = events.Filter([](int n) { return n > 0; }, { "nGe77" });
+  auto nGe77Evts = ge77.Count();
+  auto ge77Yield = ge77.Sum<double>("ge77Score");
+  auto multiplicityCut =
+    ge77.Filter([](int m) { return m > 1; }, { "multiplicity" }).Sum<double>("ge77Score");
+  auto vetoCut =
+    ge77.Filter([](bool v) { return v; }, { "vetoed" }).Sum<double>("ge77Score");
+  auto eitherCut = ge77.Filter([](int m, bool v) { return m > 1 || v; },
+                               { "multiplicity", "vetoed" })
+                     .Sum<double>("ge77Score");
+
+  // -- Ge-77 production points from the hits, once per nucleus at its weight
+  auto ge77Points =
+    events
+      .Define("firstHit",
+              [](const RVec<int>& hitID) {
+                RVec<int> first(hitID.size(), 0);
+                for(std::size_t i = 0; i < hitID.size(); ++i)
+                  first[i] = std::find(hitID.begin(), hitID.begin() + i, hitID[i]) ==
+                             hitID.begin() + i;
+                return first;
+              },
+              { "HitID" })
+      .Define("ge77X", [](const RVec<double>& x, const RVec<int>& m) { return x[m]; },
+              { "Hitxloc", "firstHit" })
+      .Define("ge77Y", [](const RVec<double>& y, const RVec<int>& m) { return y[m]; },
+              { "Hityloc", "firstHit" })
+      .Define("ge77Z", [](const RVec<double>& z, const RVec<int>& m) { return z[m]; },
+              { "Hitzloc", "firstHit" })
+      .Define("ge77R",
+              [](const RVec<double>& x, const RVec<double>& y) {
+                return ROOT::VecOps::sqrt(x * x + y * y);
+              },
+              { "ge77X", "ge77Y" })
+      .Define("ge77W", [](const RVec<double>& w, const RVec<int>& m) { return w[m]; },
+              { "Weight", "firstHit" });
+  auto ge77RZ = ge77Points.Histo2D({ "ge77RZ", "Ge-77 production;r [m];z [m]", 100, 0.,
+                                     rMax, 200, -zMax, zMax },
+                                   "ge77R", "ge77Z", "ge77W");
+  auto ge77XY = ge77Points.Histo2D({ "ge77XY", "Ge-77 production;x [m];y [m]", 200, -rMax,
+                                     rMax, 200, -rMax, rMax },
+                                   "ge77X", "ge77Y", "ge77W");
+
+  // -- neutron capture points, once per capture from its residual nucleus; the
+  // -- ntuple has no capture weights, so these are counts
+  auto captures =
+    events
+      .Define("nucleus", [](const RVec<int>& a) { return a > 1; }, { "nCapture_A" })
+      .Define("captureX", [](const RVec<double>& x, const RVec<int>& m) { return x[m]; },
+              { "nCapture_x", "nucleus" })
+      .Define("captureY", [](const RVec<double>& y, const RVec<int>& m) { return y[m]; },
+              { "nCapture_y", "nucleus" })
+      .Define("captureZ", [](const RVec<double>& z, const RVec<int>& m) { return z[m]; },
+              { "nCapture_z", "nucleus" })
+      .Define("captureR",
+              [](const RVec<double>& x, const RVec<double>& y) {
+                return ROOT::VecOps::sqrt(x * x + y * y);
+              },
+              { "captureX", "captureY" });
+  auto captureRZ =
+    captures.Histo2D({ "ntupleCaptureRZ", "Neutron captures;r [m];z [m]", 100, 0., rMax,
+                       200, -zMax, zMax },
+                     "captureR", "captureZ");
+  auto captureXY =
+    captures.Histo2D({ "ntupleCaptureXY", "Neutron captures;x [m];y [m]", 200, -rMax,
+                       rMax, 200, -rMax, rMax },
+                     "captureX", "captureY");
+
+  // -- the simulated events, not only the written ones, normalise the yield
+  double simulated = 0.;
+  if(!summaryFiles.empty())
+    simulated =
+      ROOT::RDataFrame("RunSummary", summaryFiles).Sum<int>("Events").GetValue();
+  double n = (simulated > 0.) ? simulated : (double) *nEvents;
+
+  // relative variance of the mean yield, from the per-event scores
+  double relativeError = 0.;
+  if(*yield > 0. && n > 1.)
+    relativeError = std::sqrt(std::max(*yield2 / (*yield * *yield) - 1. / n, 0.));
+
+  std::cout << "Files: " << scoreFiles.size() << " with a Score ntuple" << std::endl;
+  std::cout << "Events written: " << *nEvents << ", simulated: "
+            << ((simulated > 0.) ? std::to_string((long long) simulated)
+                                 : std::string("unknown, no RunSummary"))
+            << std::endl;
+  std::cout << "Ge-77 nuclei: " << *nGe77 << " in " << *nGe77Evts << " events"
+            << std::endl;
+  std::cout << "Weighted Ge-77 yield: " << *yield / n << " per event, relative error "
+            << relativeError << std::endl;
+  std::cout << "Weighted fraction of Ge-77 events rejected by" << std::endl;
+  std::cout << "  multiplicity > 1: " << Fraction(*multiplicityCut, *ge77Yield)
+            << std::endl;
+  std::cout << "  muon veto: " << Fraction(*vetoCut, *ge77Yield) << std::endl;
+  std::cout << "  either: " << Fraction(*eitherCut, *ge77Yield) << std::endl;
+
+  TFile output(outputFileName.c_str(), "RECREATE");
+  ge77RZ->Write();
+  ge77XY->Write();
+  captureRZ->Write();
+  captureXY->Write();
+  for(const auto& histogram : histograms)
+    histogram.second->Write();
+  std::cout << "Ge-77, capture and " << histograms.size() << " run histograms written to "
+            << outputFileName << std::endl;
+
+  return 0;
+}